@@ -0,0 +1,171 @@
+/*=====================================================================
+ * @file   bench_io.c
+ * @brief  Throughput benchmark for the line indexing of io.c.
+ * @details
+ * Generates a synthetic input with short, day01-like lines and compares
+ * the line splitting throughput (GB/s) of the classic fgets() + strlen()
+ * loop with read() + io_index_lines().
+ *
+ * Usage: bench_io [size in MB (default 256)]
+ *
+ * @author R. Middel
+ * @date   2026-01-20
+ *
+ * @license
+ *      SPDX‑License-Identifier: MIT
+ *=====================================================================*/
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "aoc.h"
+#include "io.h"
+
+#define BENCH_REPEATS 5
+
+static volatile size_t sink;
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Writes a file with random rotation lines like "L68".
+ */
+static size_t generate_input(const char* path, size_t size)
+{
+    FILE* fp = fopen(path, "w");
+    if (!fp)
+    {
+        perror("fopen");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t written = 0;
+    while (written < size)
+    {
+        int n = fprintf(fp, "%c%d\n", (rand() & 1) ? 'L' : 'R', rand() % 1000);
+        written += (size_t) n;
+    }
+    fclose(fp);
+    return written;
+}
+
+/**
+ * @brief The original io_read_input() splitting: fgets() into a 4 KB buffer and strlen().
+ */
+static size_t bench_fgets(const char* path)
+{
+    FILE* fp = fopen(path, "r");
+    char buf[MAX_LINE_LEN];
+    size_t lines = 0, bytes = 0;
+    if (!fp)
+    {
+        perror("fopen");
+        exit(EXIT_FAILURE);
+    }
+
+    while (fgets(buf, sizeof buf, fp))
+    {
+        bytes += strlen(buf);
+        lines++;
+    }
+    fclose(fp);
+    sink = bytes; /* keep the strlen() calls alive */
+    return lines;
+}
+
+/**
+ * @brief read() a file into a buffer of (at least) its size.
+ */
+static size_t read_file(const char* path, char* data, size_t size)
+{
+    int fd = open(path, O_RDONLY);
+    size_t total = 0;
+    ssize_t bytes;
+    if (fd < 0)
+    {
+        perror("open");
+        exit(EXIT_FAILURE);
+    }
+    while (total < size && (bytes = read(fd, data + total, size - total)) > 0)
+    {
+        total += (size_t) bytes;
+    }
+    close(fd);
+    return total;
+}
+
+/**
+ * @brief read() the whole file, then build the line table with io_index_lines().
+ */
+static size_t bench_index(const char* path, char* data, size_t size, io_line_t* lines)
+{
+    return io_index_lines(data, read_file(path, data, size), lines);
+}
+
+int main(int argc, char** argv)
+{
+    size_t megabytes = argc > 1 ? (size_t) strtoul(argv[1], NULL, 10) : 256;
+    char path[] = "/tmp/bench_io_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0)
+    {
+        perror("mkstemp");
+        return EXIT_FAILURE;
+    }
+    close(fd);
+
+    size_t size = generate_input(path, megabytes * 1024 * 1024);
+    char* data = malloc(size);
+    if (!data)
+    {
+        fprintf(stderr, "not enough memory for %zu bytes\n", size);
+        unlink(path);
+        return EXIT_FAILURE;
+    }
+    size_t line_count = io_count_lines(data, read_file(path, data, size));
+    io_line_t* lines = malloc(line_count * sizeof(io_line_t));
+    if (!lines)
+    {
+        fprintf(stderr, "not enough memory for %zu lines\n", line_count);
+        free(data);
+        unlink(path);
+        return EXIT_FAILURE;
+    }
+
+    double best_fgets = 1e30, best_index = 1e30, best_memory = 1e30;
+    size_t lines_fgets = 0, lines_index = 0, lines_memory = 0;
+    for (int repeat = 0; repeat < BENCH_REPEATS; repeat++)
+    {
+        double start = now();
+        lines_fgets = bench_fgets(path);
+        double middle = now();
+        lines_index = bench_index(path, data, size, lines);
+        double end = now();
+        lines_memory = io_index_lines(data, size, lines);
+        double last = now();
+
+        if (middle - start < best_fgets) best_fgets = middle - start;
+        if (end - middle < best_index) best_index = end - middle;
+        if (last - end < best_memory) best_memory = last - end;
+    }
+
+    printf("input: %zu bytes, %zu lines (best of %d)\n", size, line_count, BENCH_REPEATS);
+    printf("  fgets + strlen             : %8.3f GB/s (%zu lines)\n", (double) size / best_fgets / 1e9, lines_fgets);
+    printf("  read + io_index_lines      : %8.3f GB/s (%zu lines)\n", (double) size / best_index / 1e9, lines_index);
+    printf("  io_index_lines (in memory) : %8.3f GB/s (%zu lines)\n", (double) size / best_memory / 1e9, lines_memory);
+
+    free(lines);
+    free(data);
+    unlink(path);
+    return EXIT_SUCCESS;
+}
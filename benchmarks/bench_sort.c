@@ -0,0 +1,214 @@
+/*=====================================================================
+ * @file   bench_sort.c
+ * @brief  Benchmark of the sorts of sort.c.
+ * @details
+ * Sorts random uint64_t arrays and random ranges of 1K up to 100M
+ * elements (in steps of 10x) with libc qsort(), with the introsorts that
+ * SORT_DEFINE() generates and with the radix sorts, and reports the best
+ * time per element of each. Then the largest size is sorted by the
+ * parallel sorts on 1, 2, 4, 8 and 16 threads to report their speedup.
+ *
+ * Usage: bench_sort [maximum number of elements (default 100000000)]
+ *
+ * @author R. Middel
+ * @date   2026-01-20
+ *
+ * @license
+ *      SPDX‑License-Identifier: MIT
+ *=====================================================================*/
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "aoc.h"
+#include "parallel.h"
+#include "sort.h"
+
+#define BENCH_REPEATS 3
+#define BENCH_QSORT_LIMIT 10000000 /* the comparison sorts get slow beyond this */
+#define BENCH_MAX_THREADS 16
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief 64-bit random numbers (xorshift64*), rand() only has 31 bits.
+ */
+static uint64_t random_u64(void)
+{
+    static uint64_t state = 0x9E3779B97F4A7C15ULL;
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+static int compare_uint64(const void* left, const void* right)
+{
+    uint64_t a = *(const uint64_t*) left;
+    uint64_t b = *(const uint64_t*) right;
+    return (a > b) - (a < b);
+}
+
+static int compare_range(const void* left, const void* right)
+{
+    uint64_t a = ((const range_t*) left)->start;
+    uint64_t b = ((const range_t*) right)->start;
+    return (a > b) - (a < b);
+}
+
+static void fill_ranges(range_t* ranges, const uint64_t* input, size_t count)
+{
+    for (size_t index = 0; index < count; index++)
+    {
+        ranges[index].start = input[index];
+        ranges[index].end_including = input[index] + 1;
+    }
+}
+
+/**
+ * @brief Checks the result so the benchmark cannot silently measure a broken sort.
+ */
+static void verify_uint64(const uint64_t* array, size_t count)
+{
+    for (size_t index = 1; index < count; index++)
+    {
+        if (array[index - 1] > array[index])
+        {
+            fprintf(stderr, "unsorted output at %zu\n", index);
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    size_t maximum = argc > 1 ? (size_t) strtoull(argv[1], NULL, 10) : 100000000;
+
+    uint64_t* input = malloc(maximum * sizeof(uint64_t));
+    uint64_t* array = malloc(maximum * sizeof(uint64_t));
+    uint64_t* scratch = malloc(maximum * sizeof(uint64_t));
+    range_t* ranges = malloc(maximum * sizeof(range_t));
+    range_t* range_scratch = malloc(maximum * sizeof(range_t));
+    if (!input || !array || !scratch || !ranges || !range_scratch)
+    {
+        fprintf(stderr, "not enough memory for %zu elements\n", maximum);
+        return EXIT_FAILURE;
+    }
+    for (size_t index = 0; index < maximum; index++)
+    {
+        input[index] = random_u64();
+    }
+
+    printf("%12s %14s %14s %14s %14s %14s %14s\n", "elements", "qsort u64", "intro u64", "radix u64",
+           "qsort range", "intro range", "radix range");
+    for (size_t count = 1000; count <= maximum; count *= 10)
+    {
+        double best[6] = {1e30, 1e30, 1e30, 1e30, 1e30, 1e30};
+        for (int repeat = 0; repeat < BENCH_REPEATS; repeat++)
+        {
+            double start, elapsed;
+            if (count <= BENCH_QSORT_LIMIT)
+            {
+                memcpy(array, input, count * sizeof(uint64_t));
+                start = now();
+                qsort(array, count, sizeof(uint64_t), compare_uint64);
+                elapsed = now() - start;
+                best[0] = elapsed < best[0] ? elapsed : best[0];
+
+                memcpy(array, input, count * sizeof(uint64_t));
+                start = now();
+                introsort_uint64(array, count);
+                elapsed = now() - start;
+                best[1] = elapsed < best[1] ? elapsed : best[1];
+                verify_uint64(array, count);
+            }
+
+            memcpy(array, input, count * sizeof(uint64_t));
+            start = now();
+            radix_sort_uint64(array, count, scratch);
+            elapsed = now() - start;
+            best[2] = elapsed < best[2] ? elapsed : best[2];
+            verify_uint64(array, count);
+
+            if (count <= BENCH_QSORT_LIMIT)
+            {
+                fill_ranges(ranges, input, count);
+                start = now();
+                qsort(ranges, count, sizeof(range_t), compare_range);
+                elapsed = now() - start;
+                best[3] = elapsed < best[3] ? elapsed : best[3];
+
+                fill_ranges(ranges, input, count);
+                start = now();
+                introsort_range(ranges, count);
+                elapsed = now() - start;
+                best[4] = elapsed < best[4] ? elapsed : best[4];
+            }
+
+            fill_ranges(ranges, input, count);
+            start = now();
+            radix_sort_range(ranges, count, range_scratch);
+            elapsed = now() - start;
+            best[5] = elapsed < best[5] ? elapsed : best[5];
+        }
+
+        printf("%12zu", count);
+        for (int column = 0; column < 6; column++)
+        {
+            if (best[column] < 1e30)
+            {
+                printf(" %11.2f ns", best[column] * 1e9 / (double) count);
+            }
+            else
+            {
+                printf(" %14s", "-");
+            }
+        }
+        printf("\n");
+    }
+
+    printf("\nparallel sort of %zu elements\n", maximum);
+    printf("%8s %12s %9s %12s %9s\n", "threads", "u64 ms", "speedup", "range ms", "speedup");
+    double base[2] = {0, 0};
+    for (unsigned threads = 1; threads <= BENCH_MAX_THREADS; threads *= 2)
+    {
+        double best[2] = {1e30, 1e30};
+        for (int repeat = 0; repeat < BENCH_REPEATS; repeat++)
+        {
+            memcpy(array, input, maximum * sizeof(uint64_t));
+            double start = now();
+            parallel_sort_uint64(array, maximum, scratch, threads);
+            double elapsed = now() - start;
+            best[0] = elapsed < best[0] ? elapsed : best[0];
+            verify_uint64(array, maximum);
+
+            fill_ranges(ranges, input, maximum);
+            start = now();
+            parallel_sort_range(ranges, maximum, range_scratch, threads);
+            elapsed = now() - start;
+            best[1] = elapsed < best[1] ? elapsed : best[1];
+        }
+        if (1 == threads)
+        {
+            base[0] = best[0];
+            base[1] = best[1];
+        }
+        printf("%8u %12.1f %8.2fx %12.1f %8.2fx\n", threads, best[0] * 1e3, base[0] / best[0], best[1] * 1e3,
+               base[1] / best[1]);
+    }
+
+    free(range_scratch);
+    free(ranges);
+    free(scratch);
+    free(array);
+    free(input);
+    return EXIT_SUCCESS;
+}
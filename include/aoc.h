@@ -32,9 +32,12 @@ extern "C" {
 #endif
 
 typedef struct {
-    char* cells;
+    char* cells;        /* first cell of the first row */
     uint32_t columns;
     uint32_t rows;
+    uint32_t stride;    /* bytes between two rows, a multiple of 64 */
+    char* buffer;       /* allocation holding the cells and the sentinel ring */
+    size_t buffer_size; /* size of buffer in bytes */
 } grid_t;
 
 typedef struct {
@@ -42,14 +45,61 @@ typedef struct {
     uint16_t row;
 } position_t;
 
-int32_t day01_part1(void);
-int32_t day01_part2(void);
+typedef struct range {
+    uint64_t start;
+    uint64_t end_including;
+} range_t;
+
+uint64_t day01_part1(void);
+uint64_t day01_part2(void);
+/**
+ * @brief Count the zeros of a rotation tape one rotation at a time
+ * The plain scalar scan from the start position, the reference for the
+ * chunked AVX2 scan behind the parts.
+ * @param rotations signed clicks per rotation: negative for L, positive for R
+ * @param count     number of rotations
+ * @param stops     set to the number of rotations that end at 0 (part 1)
+ * @param hits      set to the number of clicks that reach 0 (part 2)
+ */
+void day01_count_zeros_scalar(const int16_t* rotations, size_t count, uint64_t* stops, uint64_t* hits);
 
 uint64_t day02_part1(void);
 uint64_t day02_part2(void);
+/**
+ * @brief Check one ID for part 1: its digits are a block repeated twice
+ * @param id the ID
+ * @return uint64_t id when it is invalid, else 0
+ */
+uint64_t return_value_if_invalid_id(uint64_t id);
+/**
+ * @brief Check one ID for part 2: its digits are a block repeated at least twice
+ * @param id the ID
+ * @return uint64_t id when it is invalid, else 0
+ */
+uint64_t return_value_if_invalid_id_part2(uint64_t id);
+/**
+ * @brief Sum the invalid IDs of ranges by checking every ID, on all threads
+ * The IDs are split into shards of equal count, checked AVX2 batch at a
+ * time when the CPU has it. Used by the parts with AOC_DAY02_BRUTE_FORCE.
+ * @param ranges     the ID ranges, not overlapping
+ * @param count      number of ranges
+ * @param any_repeat 0 for part 1, else part 2
+ * @return uint64_t the sum (modulo 2^64), or -EXIT_FAILURE on error
+ */
+uint64_t day02_brute_force_sum(const range_t* ranges, size_t count, int any_repeat);
 
 uint32_t day03_part1(void);
 __uint128_t day03_part2(void);
+/**
+ * @brief Solves Day 03 Part 2 exactly, whatever the number of batteries kept.
+ * @return char* The result in decimal, to be released with free(); NULL on error
+ */
+char* day03_part2_str(void);
+/**
+ * @brief Set how many batteries day03_part2() turns on per bank.
+ * @param keep The number of batteries, or 0 for the puzzle's 12
+ */
+void day03_set_keep(size_t keep);
 
 uint32_t day04_part1(void);
 uint32_t day04_part2(void);
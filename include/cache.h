@@ -0,0 +1,92 @@
+/*=====================================================================
+ * @file   cache.h
+ * @brief  Header file for the pre-parsed binary input cache.
+ * @details 
+ * This module stores the parsed representation of a puzzle input in a
+ * versioned ".aocbin" file under AOC_INPUT_CACHE_DIR (the build directory
+ * by default). The cache is keyed by the size, modification time and hash
+ * of the input; later runs map the cache file and skip text parsing
+ * entirely. A cache hit only stats the input: the input is hashed (read
+ * in full) when its modification time changed but its size did not.
+ *
+ * @author R. Middel
+ * @date   2026-01-20
+ *
+ * @license
+ *      SPDX‑License-Identifier: MIT
+ *
+ * @notes
+ *      • The cache is only used when AOC_INPUT_CACHE is enabled in CMake,
+ *        and never by the tests (TESTING).
+ *      • Cache files are native-endian and not meant to be shared.
+ *=====================================================================*/
+
+#ifndef __AOC_CACHE_H__
+#define __AOC_CACHE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CACHE_EXTENSION ".aocbin"
+#define CACHE_VERSION 1
+
+/**
+ * @brief A part of the payload written by cache_store().
+ * The sections are written back to back, so the payload read by
+ * cache_load() is their concatenation.
+ */
+typedef struct {
+    const void* data;
+    size_t size;
+} cache_section_t;
+
+/**
+ * @brief A cache file mapped into memory.
+ */
+typedef struct {
+    const void* payload; /* the stored payload (8-byte aligned) */
+    size_t payload_size; /* size of the payload in bytes */
+    void* mapping;       /* the mapped cache file */
+    size_t mapping_size; /* size of the mapping in bytes */
+} cache_t;
+
+/* Exported function prototypes --------------------------------------- */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Load the cached representation of an input file
+ * The cache is only accepted when its version and format match and the
+ * size of the input is unchanged. When the modification time changed
+ * too, the input is hashed and must still match the stored hash.
+ *
+ * @param filename The name of the input file (relative to AOC_PUZZLE_INPUT_PATH)
+ * @param format   Day specific tag describing the payload layout
+ * @param cache    The cache to fill
+ * @return uint32_t EXIT_SUCCESS when a valid cache was mapped; EXIT_FAILURE otherwise
+ */
+uint32_t cache_load(const char* filename, uint32_t format, cache_t* cache);
+/**
+ * @brief Store the parsed representation of an input file
+ * The cache file is written to AOC_INPUT_CACHE_DIR and atomically
+ * replaces an older one.
+ *
+ * @param filename      The name of the input file (relative to AOC_PUZZLE_INPUT_PATH)
+ * @param format        Day specific tag describing the payload layout
+ * @param sections      The parts of the payload
+ * @param section_count Number of entries in sections
+ * @return uint32_t EXIT_SUCCESS on success; EXIT_FAILURE otherwise
+ */
+uint32_t cache_store(const char* filename, uint32_t format, const cache_section_t* sections, size_t section_count);
+/**
+ * @brief Release a cache mapped by cache_load()
+ * @param cache The cache to release
+ */
+void cache_release(cache_t* cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __AOC_CACHE_H__
@@ -23,14 +23,74 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+/* Number of decimal digits of UINT64_MAX; a u64_to_str() buffer needs one more */
+#define U64_MAX_DIGITS 20
+
+/* Delimiter that makes a tokenizer split on runs of whitespace */
+#define TOKENIZER_WHITESPACE '\0'
+
+/**
+ * @brief Reentrant, zero-copy tokenizer over a caller-owned buffer.
+ * Tokens are handed out as (pointer, length) views into the buffer; the
+ * buffer is never modified and nothing is allocated. All state lives in
+ * the tokenizer itself, so several tokenizers can run at the same time.
+ */
+typedef struct {
+    const char* cursor; /* start of the unprocessed part of the buffer */
+    const char* end;    /* end of the buffer */
+    char delimiter;     /* single-byte delimiter or TOKENIZER_WHITESPACE */
+} tokenizer_t;
+
 /* Exported function prototypes --------------------------------------- */
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* 10^0 .. 10^19, every power of 10 that fits in a uint64_t */
+extern const uint64_t u64_powers_of_10[U64_MAX_DIGITS];
+
+/**
+ * @brief Get 10^exponent
+ *
+ * @param exponent Power of 10, at most U64_MAX_DIGITS - 1
+ * @return uint64_t 10^exponent
+ */
+static inline uint64_t u64_pow10(unsigned exponent)
+{
+    return u64_powers_of_10[exponent];
+}
+
+/**
+ * @brief Count the decimal digits of a value without branches
+ * The bit length gives an estimate of log10 (1233 / 4096 ~ log10(2)) that
+ * is at most one too low; a single table compare corrects it. 0 has one
+ * digit, like its string form.
+ *
+ * @param value Value to measure
+ * @return unsigned Number of decimal digits (1 .. U64_MAX_DIGITS)
+ */
+static inline unsigned u64_digit_count(uint64_t value)
+{
+    unsigned bits = 64u - (unsigned) __builtin_clzll(value | 1);
+    unsigned estimate = (bits * 1233u) >> 12;
+    return estimate + 1u - ((value | 1) < u64_powers_of_10[estimate]);
+}
+
+/**
+ * @brief Convert a uint64_t value to its decimal string
+ * Writes two digits per step from a lookup table, without snprintf().
+ *
+ * @param value  Value to convert
+ * @param buffer Buffer of at least U64_MAX_DIGITS + 1 characters (cannot be NULL),
+ *               filled with the NUL-terminated digits
+ * @return size_t Number of digits written, without the NUL
+ */
+size_t u64_to_str(uint64_t value, char* buffer);
+
 /**
  * @brief Convert a long value to a string
- * Convert the given long value into a string 
+ * Convert the given long value into a string with u64_to_str(). Like
+ * snprintf(), a result that does not fit is truncated.
  * 
  * @param value Long value to convert
  * @param buffer The buffer to store the value (cannot be NULL)
@@ -48,6 +108,26 @@ void long_to_str(long value, char* buffer, size_t buffersize);
  */
 int split_string(const char* src, char delim, char** left, char** right);
 char* aoc_strdup(const char* s);
+/**
+ * @brief Initialise a tokenizer
+ * With a single-byte delimiter every field between two delimiters is a
+ * token (so empty tokens are possible, but an empty buffer has none). With TOKENIZER_WHITESPACE runs of
+ * blanks separate the tokens and leading/trailing blanks are skipped.
+ *
+ * @param tokenizer The tokenizer to initialise
+ * @param src       The buffer to split (does not need to be NUL-terminated)
+ * @param length    Number of characters in src
+ * @param delimiter The delimiter, or TOKENIZER_WHITESPACE
+ */
+void tokenizer_init(tokenizer_t* tokenizer, const char* src, size_t length, char delimiter);
+/**
+ * @brief Get the next token
+ * @param tokenizer The tokenizer to advance
+ * @param token     Pointer to the first character of the token
+ * @param length    Number of characters in the token
+ * @return int 1 when a token was found; 0 when the buffer is exhausted
+ */
+int tokenizer_next(tokenizer_t* tokenizer, const char** token, size_t* length);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,103 @@
+/*=====================================================================
+ * @file   interval.h
+ * @brief  Header file for interval.c
+ * @details
+ * This module contains a set of uint64_t values stored as sorted,
+ * disjoint ranges, with the queries the puzzles need on it.
+ *
+ * @author R. Middel
+ * @date   2026-01-20
+ *
+ * @license
+ *      SPDX‑License-Identifier: MIT
+ *
+ * @notes
+ *   • aoc.h: range_t.
+ *=====================================================================*/
+
+#ifndef __AOC_INTERVAL_H__
+#define __AOC_INTERVAL_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "aoc.h"
+
+/**
+ * @brief A normalized set of intervals.
+ * The ranges are sorted by start, and neither overlap nor touch: there is
+ * always at least one value between two of them.
+ */
+typedef struct {
+    range_t* ranges; /* the intervals, owned by the set */
+    size_t count;    /* number of intervals */
+} interval_set_t;
+
+/* Exported function prototypes --------------------------------------- */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Normalize ranges in place
+ * Drops empty ranges (start > end_including), sorts the rest with the
+ * radix sort and coalesces overlapping and adjacent ones.
+ *
+ * @param ranges  ranges to normalize (the result ends up at the front)
+ * @param count   number of ranges
+ * @param scratch buffer of at least count ranges for the sort
+ * @return size_t number of ranges left
+ */
+size_t interval_normalize(range_t* ranges, size_t count, range_t* scratch);
+/**
+ * @brief Build a set from arbitrary ranges
+ *
+ * @param set    the set to fill; release it with interval_set_free()
+ * @param ranges the ranges, in any order, possibly overlapping (not modified)
+ * @param count  number of ranges
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE when out of memory
+ */
+uint32_t interval_set_build(interval_set_t* set, const range_t* ranges, size_t count);
+/**
+ * @brief Release a set
+ * @param set the set to release; it is left empty
+ */
+void interval_set_free(interval_set_t* set);
+/**
+ * @brief Get the union of two sets in linear time
+ *
+ * @param set   the set to fill; release it with interval_set_free()
+ * @param left  first set
+ * @param right second set
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE when out of memory
+ */
+uint32_t interval_set_union(interval_set_t* set, const interval_set_t* left, const interval_set_t* right);
+/**
+ * @brief Get the part of a set inside [first, last]
+ *
+ * @param set    the set to fill; release it with interval_set_free()
+ * @param source the set to clip
+ * @param first  lowest value to keep
+ * @param last   highest value to keep
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE when out of memory
+ */
+uint32_t interval_set_clip(interval_set_t* set, const interval_set_t* source, uint64_t first, uint64_t last);
+/**
+ * @brief Count the values in a set
+ * @param set the set
+ * @return __uint128_t number of values covered (2^64 when the set holds every uint64_t)
+ */
+__uint128_t interval_set_length(const interval_set_t* set);
+/**
+ * @brief Check whether a value is in a set, in O(log count)
+ * @param set   the set
+ * @param value the value to look up
+ * @return int 1 when a range of the set holds value, else 0
+ */
+int interval_set_contains(const interval_set_t* set, uint64_t value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __AOC_INTERVAL_H__
@@ -26,7 +26,16 @@
 #include <stdlib.h>
 
 #define MAX_LINE_LEN 1024 * 4
+#define IO_MAX_PATH_LEN 1024
 #define INITIAL_CAPACITY 8
+#define IO_READER_BUFFER_SIZE (64 * 1024)
+#define IO_STREAM_BUFFER_SIZE (64 * 1024)
+#define IO_PIPELINE_CHUNK_SIZE (256 * 1024)
+#define IO_PIPELINE_CHUNKS 4
+#define IO_PIPELINE_MIN_SIZE (1024 * 1024)
+#define IO_PREFETCH_MAX_FILES 32
+#define GRID_ALIGNMENT 64
+#define GRID_SENTINEL '\0'
 
 #if defined(_WIN32) || defined(_WIN64)
 /* Windows */
@@ -36,11 +45,87 @@
 #define PATH_SEPARATOR '/'
 #endif
 
+/* Exported types ----------------------------------------------------- */
+
+/**
+ * @brief A read-only view on a single line of input.
+ * The view points into memory owned by someone else (e.g. a mapping) and
+ * is NOT NUL-terminated. The trailing newline is not part of the view.
+ */
+typedef struct {
+    const char* data;
+    size_t length;
+} io_line_t;
+
+/**
+ * @brief An input file mapped into memory together with its line views.
+ */
+typedef struct {
+    const char* data;  /* start of the content (NULL for an empty file) */
+    size_t size;       /* size of the content in bytes */
+    io_line_t* lines;  /* one view per line, pointing into the content */
+    size_t line_count; /* number of entries in lines */
+    void* mapping;     /* the mmap()ed file, NULL when the content is an input stream */
+    char* buffer;      /* decompressed content owned by the input, or NULL */
+} io_mapped_input_t;
+
+/**
+ * @brief A file read through an optional gzip/zstd decompressor (opaque).
+ */
+typedef struct io_stream io_stream_t;
+
+/**
+ * @brief A reader thread feeding chunks of a file to the parser (opaque).
+ */
+typedef struct io_pipeline io_pipeline_t;
+
+/**
+ * @brief Iterator handing out the lines of a file one at a time.
+ * Lines are read through a refillable buffer, so memory stays at
+ * O(buffer) no matter how large the file is. The buffer grows only when
+ * a single line does not fit, so lines can have any length. Large files
+ * and pipes are read ahead by a separate thread into a small ring of
+ * chunks, so reading overlaps with the caller's parsing.
+ */
+typedef struct {
+    int fd;                  /* file being read (-1 when reading an input stream) */
+    io_stream_t* stream;     /* decompressing reader on fd, NULL for an input stream */
+    io_pipeline_t* pipeline; /* reader thread for large files and pipes, or NULL */
+    const char* source;      /* input stream held in memory, or NULL when reading from fd */
+    size_t source_size;      /* size of source in bytes */
+    size_t source_read;      /* bytes of source already copied into buffer */
+    char* buffer;            /* refillable read buffer (pipelined: the line straddling two chunks) */
+    size_t capacity;         /* size of buffer in bytes */
+    size_t start;            /* first byte not yet handed out */
+    size_t end;              /* end of the valid data in buffer */
+    int eof;                 /* set once the file is exhausted */
+    int error;               /* set when reading failed */
+} io_line_reader_t;
+
 /* Exported function prototypes --------------------------------------- */
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Counts the lines in a buffer.
+ * A last line without a trailing newline is counted as well.
+ * @param data The buffer to scan
+ * @param size The number of bytes in the buffer
+ * @return size_t The number of lines
+ */
+size_t io_count_lines(const char* data, size_t size);
+/**
+ * @brief Builds the line table of a buffer.
+ * The buffer is scanned 64 (AVX2) or 16 (SSE2) bytes at a time and one
+ * view is emitted per line. The newline is not part of a view.
+ * @param data  The buffer to index
+ * @param size  The number of bytes in the buffer
+ * @param lines The views to fill; must hold io_count_lines(data, size) entries
+ * @return size_t The number of lines indexed
+ */
+size_t io_index_lines(const char* data, size_t size, io_line_t* lines);
+
 /**
  * @brief Concatenates two strings with a '/' separator.
  * This function appends the source string to the destination string,
@@ -50,10 +135,37 @@ extern "C" {
  * @return char* Pointer to the concatenated string.
  */
 char* io_strcat(char* dest, const char* src);
+/**
+ * @brief Builds the full path of an input file.
+ * When an input was selected with io_set_input() its path is used instead.
+ * @param filename  The name of the input file (relative to AOC_PUZZLE_INPUT_PATH).
+ * @param full_path Buffer of IO_MAX_PATH_LEN bytes to store the path
+ * @return char* Pointer to full_path.
+ */
+char* io_input_path(const char* filename, char* full_path);
+/**
+ * @brief Selects the input used by all loaders instead of the puzzle input files.
+ * Every file name then resolves to this input. A regular file is read
+ * (or mapped) like any other input. Stdin ("-") and pipes cannot be
+ * mapped or read twice, so they are read into memory once and every
+ * loader works on that copy.
+ * @param path The input file, "-" for stdin, or NULL to go back to
+ *             AOC_PUZZLE_INPUT_PATH (and release a buffered stream)
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
+ */
+uint32_t io_set_input(const char* path);
+/**
+ * @brief Tells whether the selected input is a stream held in memory.
+ * @return int Non-zero for stdin and pipes, 0 for regular files
+ */
+int io_input_is_stream(void);
 /**
  * @brief Reads input data from a specified file.
- * This function opens the file, reads its contents, and processes
- * the input data as required by the application.
+ * The complete file is read into a single arena (decompressing gzip and
+ * zstd files on the way). Every line is stored at its exact length
+ * (NUL-terminated, without the newline) and the line table lives in the
+ * same allocation, so loading costs O(1) allocations.
+ * Release the result with io_free_input().
  * @param filename The path to the input file.
  * @param lines Pointer to an array of strings to store the read lines.
  * @param line_count Pointer to a size_t variable to store the number of lines read.
@@ -61,14 +173,81 @@ char* io_strcat(char* dest, const char* src);
  */
 uint32_t io_read_input(const char* filename, char*** out_lines, size_t* out_line_count);
 /**
- * @brief Reads input data from a specified file.
- * This function opens the file, reads its contents, and processes
- * the input data as required by the application.
+ * @brief Releases the lines returned by io_read_input().
+ * This frees the line table and the storage of every line in one go.
+ * @param lines The array of lines to release (may be NULL)
+ */
+void io_free_input(char** lines);
+/**
+ * @brief Reads a grid from a specified file.
+ * The rows are copied straight from the mapped file into a single
+ * 64-byte aligned buffer. Every row is padded to a stride that is a
+ * multiple of 64 bytes and the grid is surrounded by a one-cell ring of
+ * GRID_SENTINEL cells, so grid->cells[r * stride + c] is valid for every
+ * r in [-1, rows] and c in [-1, columns]. Release it with io_free_grid().
  * @param filename The path to the input file.
  * @param grid     A reference to the grid to fill
  * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
  */
 uint32_t io_read_grid(const char* filename, grid_t* grid);
+/**
+ * @brief Releases a grid read by io_read_grid().
+ * @param grid The grid to release
+ */
+void io_free_grid(grid_t* grid);
+/**
+ * @brief Maps an input file into memory without copying it.
+ * The file is mapped read-only and split into line views that point
+ * directly into the mapping. Nothing is copied and no per-line memory
+ * is allocated. A gzip or zstd compressed file is decompressed into
+ * memory instead. Release everything with io_unmap_input().
+ * @param filename The name of the input file (relative to AOC_PUZZLE_INPUT_PATH).
+ * @param input    The mapped input to fill
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
+ */
+uint32_t io_map_input(const char* filename, io_mapped_input_t* input);
+/**
+ * @brief Releases an input mapped by io_map_input().
+ * All line views become invalid after this call.
+ * @param input The mapped input to release
+ */
+void io_unmap_input(io_mapped_input_t* input);
+/**
+ * @brief Opens an input file for line-by-line reading.
+ * A gzip or zstd compressed file is decompressed chunk by chunk.
+ * @param filename The name of the input file (relative to AOC_PUZZLE_INPUT_PATH).
+ * @param reader   The reader to initialise
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
+ */
+uint32_t io_reader_open(const char* filename, io_line_reader_t* reader);
+/**
+ * @brief Hands out the next line of the input.
+ * The view points into the reader's buffer and stays valid until the next
+ * call. The newline is replaced by a NUL, so the view is also a C string.
+ * @param reader The reader to read from
+ * @param line   The view to fill
+ * @return int 1 when a line was read, 0 at the end of the input or on error.
+ */
+int io_reader_next(io_line_reader_t* reader, io_line_t* line);
+/**
+ * @brief Closes a reader opened with io_reader_open().
+ * @param reader The reader to close
+ */
+void io_reader_close(io_line_reader_t* reader);
+/**
+ * @brief Starts pulling input files into the page cache in the background.
+ * A background thread reads ahead the files, in order, into the kernel's
+ * page cache. Nothing is kept in the process: the loaders read or map
+ * the files as usual and find them cached.
+ * @param filenames The names of the input files (relative to AOC_PUZZLE_INPUT_PATH)
+ * @param count     Number of entries in filenames (at most IO_PREFETCH_MAX_FILES)
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
+ */
+uint32_t io_prefetch_start(const char* const* filenames, size_t count);
+/**
+ * @brief Stops the background thread.
+ */
+void io_prefetch_stop(void);
 
 #ifdef __cplusplus
 }
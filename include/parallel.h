@@ -0,0 +1,67 @@
+/*=====================================================================
+ * @file   parallel.h
+ * @brief  Header file for parallel.c
+ * @details 
+ * This module contains a small thread pool-less helper to spread
+ * independent tasks over a number of threads.
+ *
+ * @author R. Middel
+ * @date   2026-01-20
+ *
+ * @license
+ *      SPDX‑License-Identifier: MIT
+ *
+ * @notes
+ *   • pthreads: The worker threads.
+ *=====================================================================*/
+#ifndef __AOC_PARALLEL_H__
+#define __AOC_PARALLEL_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Upper limit for the number of threads used by parallel_for() */
+#define PARALLEL_MAX_THREADS 64
+
+/**
+ * @brief A task run by parallel_for().
+ * @param task    Index of the task, in [0, tasks)
+ * @param context The context passed to parallel_for()
+ */
+typedef void (*parallel_task_t)(size_t task, void* context);
+
+/* Exported function prototypes --------------------------------------- */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Get the default number of threads.
+ * This is the count set with parallel_set_thread_count(), or the number of
+ * online CPUs when none was set (at most PARALLEL_MAX_THREADS).
+ * @return unsigned The number of threads, at least 1
+ */
+unsigned parallel_thread_count(void);
+/**
+ * @brief Set the default number of threads.
+ * @param count The number of threads, or 0 to use the number of online CPUs
+ */
+void parallel_set_thread_count(unsigned count);
+/**
+ * @brief Run tasks 0 .. tasks - 1, spread over a number of threads.
+ * The calling thread takes part, so one thread means running the tasks
+ * in order on the caller. Threads pick the next task from a shared
+ * counter, so tasks of uneven size balance out. Returns once all tasks
+ * have finished.
+ * @param tasks   Number of tasks
+ * @param threads Number of threads, or 0 for parallel_thread_count()
+ * @param body    The task to run
+ * @param context Passed to every task
+ */
+void parallel_for(size_t tasks, unsigned threads, parallel_task_t body, void* context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __AOC_PARALLEL_H__
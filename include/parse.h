@@ -0,0 +1,74 @@
+/*=====================================================================
+ * @file   parse.h
+ * @brief  Header file for the decimal integer parsers.
+ * @details 
+ * This module contains length-aware parsers for unsigned decimal
+ * integers. They replace atoi/atol/sscanf on the hot parsing paths:
+ * the input does not need to be NUL-terminated and every parser returns
+ * the number of bytes it consumed, so a caller can continue right
+ * behind the number.
+ *
+ * @author R. Middel
+ * @date   2026-01-20
+ *
+ * @license
+ *      SPDX‑License-Identifier: MIT
+ *
+ * @notes
+ *      • Digits are converted 8 at a time (SWAR) while at least 8 bytes
+ *        of the input are left; the remainder is parsed byte by byte.
+ *      • Values that do not fit the result type wrap around.
+ *=====================================================================*/
+
+#ifndef __AOC_PARSE_H__
+#define __AOC_PARSE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Exported function prototypes --------------------------------------- */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Parse an unsigned 32-bit decimal number
+ * Parse the leading digits of src. Parsing stops at the first non-digit
+ * or after length bytes.
+ *
+ * @param src    Characters to parse (does not need to be NUL-terminated)
+ * @param length Number of characters available in src
+ * @param value  The parsed value (0 when no digits were found or the number does not fit)
+ * @return size_t Number of bytes consumed; 0 when src does not start with a digit,
+ *                or when the number does not fit 32 bits
+ */
+size_t parse_u32(const char* src, size_t length, uint32_t* value);
+/**
+ * @brief Parse an unsigned 64-bit decimal number
+ * Parse the leading digits of src. Parsing stops at the first non-digit
+ * or after length bytes.
+ *
+ * @param src    Characters to parse (does not need to be NUL-terminated)
+ * @param length Number of characters available in src
+ * @param value  The parsed value (0 when no digits were found or the number does not fit)
+ * @return size_t Number of bytes consumed; 0 when src does not start with a digit,
+ *                or when the number does not fit 64 bits
+ */
+size_t parse_u64(const char* src, size_t length, uint64_t* value);
+/**
+ * @brief Parse an unsigned 128-bit decimal number
+ * Parse the leading digits of src. Parsing stops at the first non-digit
+ * or after length bytes.
+ *
+ * @param src    Characters to parse (does not need to be NUL-terminated)
+ * @param length Number of characters available in src
+ * @param value  The parsed value (0 when no digits were found)
+ * @return size_t Number of bytes consumed; 0 when src does not start with a digit
+ */
+size_t parse_u128(const char* src, size_t length, __uint128_t* value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __AOC_PARSE_H__
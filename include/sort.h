@@ -17,25 +17,251 @@
 #ifndef __AOC_SORT_H__
 #define __AOC_SORT_H__
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include "aoc.h"
+
+/* Bits per radix pass: 6 passes of 2048 buckets cover a 64-bit key */
+#define SORT_RADIX_BITS 11
+#define SORT_RADIX_BUCKETS (1u << SORT_RADIX_BITS)
+#define SORT_RADIX_PASSES ((64 + SORT_RADIX_BITS - 1) / SORT_RADIX_BITS)
+/* Below this size an insertion sort beats the histogram passes */
+#define SORT_INSERTION_LIMIT 64
+/* Arrays shorter than this are not worth sorting on several threads */
+#define SORT_PARALLEL_MIN (1u << 16)
+/* Number of symbols counted by the counting sorts (every char value) */
+#define SORT_ALPHABET_SIZE 256
+
+/* Below this size the generated introsorts finish with an insertion sort */
+#define SORT_INTRO_CUTOFF 16
+
+/**
+ * @brief Stamp out a comparison sort for one element type
+ * Generates `static inline void name(type* array, size_t len)`, an
+ * introsort: a median-of-three quicksort that falls back to heapsort once
+ * the recursion gets deeper than 2*log2(len), and finishes partitions of
+ * up to SORT_INTRO_CUTOFF elements with an insertion sort. Elements are
+ * ordered by `key(element) < key(other)`, where key is the name of a
+ * function-like macro, so the comparison is inlined instead of going
+ * through a qsort() callback. The sort is not stable; the generated
+ * `name##_insertion()` helper is, and may be used on its own.
+ *
+ * @param name prefix of the generated functions
+ * @param type element type
+ * @param key  function-like macro that maps an element to its ordered key
+ */
+#define SORT_DEFINE(name, type, key)                                           \
+    static inline void name##_insertion(type* array, size_t len)              \
+    {                                                                          \
+        for (size_t i = 1; i < len; i++)                                       \
+        {                                                                      \
+            type item = array[i];                                              \
+            size_t j = i;                                                      \
+            for (; j > 0 && key(item) < key(array[j - 1]); j--)                \
+            {                                                                  \
+                array[j] = array[j - 1];                                       \
+            }                                                                  \
+            array[j] = item;                                                   \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static inline void name##_sift_down(type* array, size_t root, size_t len) \
+    {                                                                          \
+        type item = array[root];                                               \
+        for (size_t child = 2 * root + 1; child < len; child = 2 * root + 1)   \
+        {                                                                      \
+            if (child + 1 < len && key(array[child]) < key(array[child + 1]))  \
+            {                                                                  \
+                child++;                                                       \
+            }                                                                  \
+            if (!(key(item) < key(array[child])))                              \
+            {                                                                  \
+                break;                                                         \
+            }                                                                  \
+            array[root] = array[child];                                        \
+            root = child;                                                      \
+        }                                                                      \
+        array[root] = item;                                                    \
+    }                                                                          \
+                                                                               \
+    static inline void name##_heap(type* array, size_t len)                   \
+    {                                                                          \
+        for (size_t root = len / 2; root-- > 0;)                               \
+        {                                                                      \
+            name##_sift_down(array, root, len);                                \
+        }                                                                      \
+        for (size_t end = len; end-- > 1;)                                     \
+        {                                                                      \
+            type top = array[0];                                               \
+            array[0] = array[end];                                             \
+            array[end] = top;                                                  \
+            name##_sift_down(array, 0, end);                                   \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static inline void name##_swap(type* array, size_t left, size_t right)    \
+    {                                                                          \
+        type item = array[left];                                               \
+        array[left] = array[right];                                            \
+        array[right] = item;                                                   \
+    }                                                                          \
+                                                                               \
+    static inline void name##_intro(type* array, size_t len, unsigned depth)  \
+    {                                                                          \
+        while (len > SORT_INTRO_CUTOFF)                                        \
+        {                                                                      \
+            if (0 == depth--)                                                  \
+            {                                                                  \
+                name##_heap(array, len);                                       \
+                return;                                                        \
+            }                                                                  \
+            /* Median of three: afterwards array[0] <= pivot <= array[len-1], \
+             * which stops both scans below without bounds checks */          \
+            size_t mid = len / 2;                                              \
+            if (key(array[mid]) < key(array[0]))                               \
+            {                                                                  \
+                name##_swap(array, 0, mid);                                    \
+            }                                                                  \
+            if (key(array[len - 1]) < key(array[0]))                           \
+            {                                                                  \
+                name##_swap(array, 0, len - 1);                                \
+            }                                                                  \
+            if (key(array[len - 1]) < key(array[mid]))                         \
+            {                                                                  \
+                name##_swap(array, mid, len - 1);                              \
+            }                                                                  \
+            type pivot = array[mid];                                           \
+            size_t i = 0;                                                      \
+            size_t j = len - 1;                                                \
+            for (;;)                                                           \
+            {                                                                  \
+                while (key(array[i]) < key(pivot))                             \
+                {                                                              \
+                    i++;                                                       \
+                }                                                              \
+                while (key(pivot) < key(array[j]))                             \
+                {                                                              \
+                    j--;                                                       \
+                }                                                              \
+                if (i >= j)                                                    \
+                {                                                              \
+                    break;                                                     \
+                }                                                              \
+                name##_swap(array, i, j);                                      \
+                i++;                                                           \
+                j--;                                                           \
+            }                                                                  \
+            /* [0, i) <= pivot <= [i, len): recurse into the smaller side     \
+             * and loop on the larger one to bound the stack */               \
+            if (i < len - i)                                                   \
+            {                                                                  \
+                name##_intro(array, i, depth);                                 \
+                array += i;                                                    \
+                len -= i;                                                      \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                name##_intro(array + i, len - i, depth);                       \
+                len = i;                                                       \
+            }                                                                  \
+        }                                                                      \
+        name##_insertion(array, len);                                          \
+    }                                                                          \
+                                                                               \
+    static inline void name(type* array, size_t len)                          \
+    {                                                                          \
+        unsigned depth = 0;                                                    \
+        for (size_t n = len; n > 1; n >>= 1)                                   \
+        {                                                                      \
+            depth += 2;                                                        \
+        }                                                                      \
+        name##_intro(array, len, depth);                                       \
+    }
+
+/**
+ * @brief A key with the position it came from
+ * Sorting these pairs orders keys while remembering where every key was,
+ * e.g. to sort indices into another array by that array's values.
+ */
+typedef struct key_index {
+    uint64_t key;
+    size_t index;
+} key_index_t;
+
+#define SORT_KEY_UINT64(item) (item)
+#define SORT_KEY_RANGE(item) ((item).start)
+#define SORT_KEY_INDEX(item) ((item).key)
+
+/* introsort_uint64(), introsort_range() (by start) and introsort_key_index() (by key) */
+SORT_DEFINE(introsort_uint64, uint64_t, SORT_KEY_UINT64)
+SORT_DEFINE(introsort_range, range_t, SORT_KEY_RANGE)
+SORT_DEFINE(introsort_key_index, key_index_t, SORT_KEY_INDEX)
+
 /* Exported function prototypes --------------------------------------- */
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 /**
- * @brief Sort a uint64_t array using quick sort algorithm
- * Sort the given uint64_t array in place using the quick sort algorithm
+ * @brief Sort a uint64_t array in ascending order
+ * Sorts the array in place with radix_sort_uint64(), using a temporary
+ * scratch buffer. Kept under its old name for existing callers.
  * 
  * @param array uint64_t array to sort
  * @param len   length of the array
- * @return uint64_t* Pointer to the sorted character array
+ * @return uint64_t* Pointer to the sorted array
  */
 uint64_t* quick_sort_uint64(uint64_t* array, size_t len);
 /**
- * @brief Sort a character array using quick sort algorithm
- * Sort the given character array in place using the quick sort algorithm
+ * @brief Sort a uint64_t array with an LSD radix sort
+ * Sorts in O(n) using SORT_RADIX_PASSES passes of SORT_RADIX_BITS bits.
+ * The histograms of all passes are built in a single read of the input,
+ * and a pass is skipped when all keys share its digit. An input that is
+ * already sorted is detected up front and left alone.
+ * 
+ * @param array   uint64_t array to sort (the result ends up here)
+ * @param len     length of the array
+ * @param scratch buffer of at least len elements, its content is overwritten
+ */
+void radix_sort_uint64(uint64_t* array, size_t len, uint64_t* scratch);
+/**
+ * @brief Sort ranges by their start with an LSD radix sort
+ * The key-plus-payload variant of radix_sort_uint64(): the start is the
+ * key and end_including moves along with it. The sort is stable.
+ * 
+ * @param array   ranges to sort (the result ends up here)
+ * @param len     number of ranges
+ * @param scratch buffer of at least len ranges, its content is overwritten
+ */
+void radix_sort_range(range_t* array, size_t len, range_t* scratch);
+/**
+ * @brief Sort a uint64_t array on several threads
+ * Every thread radix sorts one chunk of the array, then the sorted chunks
+ * are merged with a parallel multiway merge: the output is cut into one
+ * part per thread at exact ranks, and every thread merges its part
+ * independently.
+ * 
+ * @param array   uint64_t array to sort (the result ends up here)
+ * @param len     length of the array
+ * @param scratch buffer of at least len elements, its content is overwritten
+ * @param threads number of threads, or 0 for parallel_thread_count()
+ */
+void parallel_sort_uint64(uint64_t* array, size_t len, uint64_t* scratch, unsigned threads);
+/**
+ * @brief Sort ranges by their start on several threads
+ * The range_t variant of parallel_sort_uint64(). The sort is stable.
+ * 
+ * @param array   ranges to sort (the result ends up here)
+ * @param len     number of ranges
+ * @param scratch buffer of at least len ranges, its content is overwritten
+ * @param threads number of threads, or 0 for parallel_thread_count()
+ */
+void parallel_sort_range(range_t* array, size_t len, range_t* scratch, unsigned threads);
+/**
+ * @brief Sort a character array in ascending order
+ * Sorts the NUL-terminated string in place with counting_sort_char().
+ * Kept under its old name for existing callers.
  * 
  * @param array Character array to sort
  * @return char* Pointer to the sorted character array
@@ -43,14 +269,56 @@ uint64_t* quick_sort_uint64(uint64_t* array, size_t len);
 char* quick_sort(char* array);
 
 /**
- * @brief Reverse Sort a character array using quick sort algorithm
- * Reverse Sort the given character array in place using the quick sort algorithm
+ * @brief Sort a character array in descending order
+ * Sorts the NUL-terminated string in place with counting_sort_char_rev().
+ * Kept under its old name for existing callers.
  * 
  * @param array Character array to sort
  * @return char* Pointer to the Reverse sorted character array
  */
 char* quick_sort_rev(char* array);
 
+/**
+ * @brief Count how often every character occurs
+ * 
+ * @param array     Characters to count (does not need to be NUL-terminated)
+ * @param len       Number of characters in array
+ * @param histogram Filled with the number of occurrences per (unsigned) character
+ */
+void char_histogram(const char* array, size_t len, size_t histogram[SORT_ALPHABET_SIZE]);
+
+/**
+ * @brief Sort a character array in ascending order with a counting sort
+ * Runs in O(len + SORT_ALPHABET_SIZE); characters compare as unsigned.
+ * 
+ * @param array Characters to sort (does not need to be NUL-terminated)
+ * @param len   Number of characters in array
+ * @return char* Pointer to the sorted array
+ */
+char* counting_sort_char(char* array, size_t len);
+
+/**
+ * @brief Sort a character array in descending order with a counting sort
+ * Runs in O(len + SORT_ALPHABET_SIZE); characters compare as unsigned.
+ * 
+ * @param array Characters to sort (does not need to be NUL-terminated)
+ * @param len   Number of characters in array
+ * @return char* Pointer to the sorted array
+ */
+char* counting_sort_char_rev(char* array, size_t len);
+
+/**
+ * @brief Get the k largest characters of a histogram without sorting
+ * E.g. for the digits of "818181" and k = 2 the result is "88".
+ * 
+ * @param histogram Histogram built by char_histogram()
+ * @param k         Number of characters wanted
+ * @param out       Buffer of at least k characters, filled in descending order
+ * @return size_t Number of characters written (less than k when the histogram
+ *         holds fewer characters)
+ */
+size_t histogram_largest(const size_t histogram[SORT_ALPHABET_SIZE], size_t k, char* out);
+
 #ifdef __cplusplus
 }
 #endif
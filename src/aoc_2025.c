@@ -23,14 +23,48 @@
 #include <getopt.h>
 
 #include "aoc.h"
+#include "io.h"
+#include "parallel.h"
 
+#define AOC_DAY_COUNT 7
 
 // Define long options
 static struct option long_options[] = {{"day", required_argument, 0, 'd'},
                                        {"part", required_argument, 0, 'p'},
+                                       {"input", required_argument, 0, 'i'},
+                                       {"threads", required_argument, 0, 't'},
+                                       {"keep", required_argument, 0, 'k'},
                                        {"help", no_argument, 0, 'h'},
                                        {0, 0, 0, 0}};
 
+/**
+ * @brief Starts reading the inputs of the selected days in the background.
+ * The inputs are pulled into the page cache while the earlier days are
+ * being solved, so the solvers find them cached instead of waiting for
+ * the disk.
+ * @param day The selected day, or 0 for all days
+ */
+static void prefetch_inputs(int day)
+{
+    char names[AOC_DAY_COUNT][16];
+    const char* filenames[AOC_DAY_COUNT];
+    size_t count = 0;
+
+    for (int index = 1; index <= AOC_DAY_COUNT; index++)
+    {
+        if (0 == day || index == day)
+        {
+            snprintf(names[count], sizeof(names[count]), "day%02d.txt", index);
+            filenames[count] = names[count];
+            count++;
+        }
+    }
+    if (count > 0)
+    {
+        io_prefetch_start(filenames, count);
+    }
+}
+
 /**
  * @brief Main entry point for the Advent of Code 2025 solutions.
  * This function initializes logging, prints a header, and executes
@@ -52,11 +86,12 @@ int main(int argc, const char **argv)
     // Variables for parsed arguments
     int day = 0;
     int part = 0; // 0 means run both parts
+    const char* input = NULL; // NULL means use the puzzle input files
     int option_index = 0;
 
     // Parse command-line arguments
     int opt;
-    while ((opt = getopt_long(argc, (char* const*) argv, "d:p:h", long_options, &option_index)) != -1)
+    while ((opt = getopt_long(argc, (char* const*) argv, "d:p:i:t:k:h", long_options, &option_index)) != -1)
     {
         switch (opt)
         {
@@ -68,11 +103,26 @@ int main(int argc, const char **argv)
                 part = atoi(optarg);
                 clog_info(__FILE__, "Part set to: %d", part);
                 break;
+            case 'i':
+                input = optarg;
+                clog_info(__FILE__, "Input set to: %s", input);
+                break;
+            case 't':
+                parallel_set_thread_count((unsigned) atoi(optarg));
+                clog_info(__FILE__, "Threads set to: %u", parallel_thread_count());
+                break;
+            case 'k':
+                day03_set_keep((size_t) strtoull(optarg, NULL, 10));
+                clog_info(__FILE__, "Keep set to: %s", optarg);
+                break;
             case 'h':
                 printf("Usage: aoc_2025 [OPTIONS]\n");
                 printf("Options:\n");
                 printf("  --day <day>, -d <day>      Run solution for specific day (default: 1)\n");
                 printf("  --part <part>, -p <part>   Run specific part: 1 or 2 (default: both)\n");
+                printf("  --input <file>, -i <file>  Read the input from <file>, or stdin for '-' (requires --day)\n");
+                printf("  --threads <n>, -t <n>      Number of worker threads (default: number of CPUs)\n");
+                printf("  --keep <k>, -k <k>         Batteries per bank in day 3 part 2 (default: 12)\n");
                 printf("  --help, -h                 Display this help message\n");
                 return EXIT_SUCCESS;
             case '?':
@@ -84,17 +134,36 @@ int main(int argc, const char **argv)
     }
 
 
+    if (input)
+    {
+        if (0 == day)
+        {
+            fprintf(stderr, "--input requires --day\n");
+            return EXIT_FAILURE;
+        }
+        if (EXIT_FAILURE == io_set_input(input))
+        {
+            fprintf(stderr, "Cannot read input: %s\n", input);
+            return EXIT_FAILURE;
+        }
+    }
+
     printf("%.*s\n", 80, "--------------------------------------------------------------------------------");
 
+    if (!input)
+    {
+        prefetch_inputs(day);
+    }
+
     // Execute based on parsed arguments
 
     if ((1 == day || 0 == day) && (part == 0 || part == 1))
     {
-        printf("Day 1 - Part 1 Result: %u\n", day01_part1());
+        printf("Day 1 - Part 1 Result: %lu\n", day01_part1());
     }
     if ((1 == day || 0 == day) && (part == 0 || part == 2))
     {
-        printf("Day 1 - Part 2 Result: %u\n", day01_part2());
+        printf("Day 1 - Part 2 Result: %lu\n", day01_part2());
     }
 
     // Execute based on parsed arguments
@@ -114,7 +183,9 @@ int main(int argc, const char **argv)
     }
     if ((3 == day || 0 == day) && (part == 0 || part == 2))
     {
-        printf("Day 3 - Part 2 Result: %llu\n", (long long unsigned int) day03_part2());
+        char* joltage = day03_part2_str();
+        printf("Day 3 - Part 2 Result: %s\n", joltage ? joltage : "-1");
+        free(joltage);
     }
 
     // Execute based on parsed arguments
@@ -156,5 +227,8 @@ int main(int argc, const char **argv)
     {
         printf("Day 7 - Part 2 Result: %lu\n", day07_part2());
     }
+
+    io_prefetch_stop();
+    io_set_input(NULL);
     return EXIT_SUCCESS;
 }
\ No newline at end of file
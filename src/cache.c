@@ -0,0 +1,323 @@
+/*=====================================================================
+ * @file   cache.c
+ * @brief  Pre-parsed binary input cache.
+ * @details 
+ * This module stores the parsed representation of a puzzle input in a
+ * versioned ".aocbin" file under AOC_INPUT_CACHE_DIR:
+ *
+ *   [cache_header_t][payload (section 0, section 1, ...)]
+ *
+ * The header records the size, modification time and hash of the input
+ * the payload was parsed from; a cache that does not match the current
+ * input is ignored (and overwritten by the next cache_store()).
+ * The tests (TESTING) never use the cache.
+ * 
+ * @author R. Middel
+ * @date   2026-01-20
+ *
+ * @license
+ *      SPDX‑License-Identifier: MIT
+ *
+ *  @notes
+ *    * External dependencies:
+ *     - CLogger: For logging functionality.
+ *     - Standard C Library: For input/output and standard utilities.
+ *=====================================================================*/
+#define _GNU_SOURCE /* st_mtim & friends under -std=c11 */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "aoc.h"
+#include "cache.h"
+#include "io.h"
+
+#define CACHE_MAGIC "AOCBIN\0"
+
+/* The tests run on the inputs in the source tree and must not leave caches behind */
+#if defined(AOC_INPUT_CACHE) && !defined(TESTING)
+#define CACHE_ENABLED 1
+#endif
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t format;
+    uint64_t input_size;
+    int64_t input_mtime_sec;
+    int64_t input_mtime_nsec;
+    uint64_t input_hash;
+    uint64_t payload_size;
+} cache_header_t;
+
+#ifdef CACHE_ENABLED
+/**
+ * @brief Hash the content of a file, 8 bytes at a time.
+ * @param data The content to hash
+ * @param size Number of bytes in data
+ * @return uint64_t The hash
+ */
+static uint64_t cache_hash(const unsigned char* data, size_t size)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL ^ size;
+    size_t index = 0;
+
+    for (; index + 8 <= size; index += 8)
+    {
+        uint64_t word;
+        memcpy(&word, data + index, sizeof(word));
+        hash = (hash ^ word) * 0x9E3779B97F4A7C15ULL;
+        hash ^= hash >> 32;
+    }
+    for (; index < size; index++)
+    {
+        hash = (hash ^ data[index]) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Fill the input part of a cache header.
+ * Hashing reads the whole input, so it is only done when asked for.
+ * @param full_path Path of the input file
+ * @param hash      Non-zero to hash the content, else input_hash is left 0
+ * @param header    The header to fill
+ * @return uint32_t EXIT_SUCCESS on success; EXIT_FAILURE otherwise
+ */
+static uint32_t cache_describe_input(const char* full_path, int hash, cache_header_t* header)
+{
+    int fd = open(full_path, O_RDONLY);
+    if (fd < 0)
+    {
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+    {
+        close(fd);
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    header->input_size = (uint64_t) st.st_size;
+    header->input_mtime_sec = (int64_t) st.st_mtim.tv_sec;
+    header->input_mtime_nsec = (int64_t) st.st_mtim.tv_nsec;
+    header->input_hash = 0;
+    if (hash)
+    {
+        header->input_hash = cache_hash(NULL, 0);
+    }
+    if (hash && st.st_size > 0)
+    {
+        void* mapping = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (MAP_FAILED == mapping)
+        {
+            close(fd);
+            return (uint32_t) EXIT_FAILURE;
+        }
+        madvise(mapping, (size_t) st.st_size, MADV_SEQUENTIAL);
+        header->input_hash = cache_hash((const unsigned char*) mapping, (size_t) st.st_size);
+        munmap(mapping, (size_t) st.st_size);
+    }
+
+    close(fd);
+    return (uint32_t) EXIT_SUCCESS;
+}
+
+/**
+ * @brief Get the path of the cache file of an input.
+ * Caches live in AOC_INPUT_CACHE_DIR, never next to the input. The name
+ * holds a hash of the absolute input path, so inputs with the same name
+ * in different directories get their own cache.
+ * @param full_path  Path of the input file
+ * @param cache_path Buffer of IO_MAX_PATH_LEN bytes to store the path
+ * @return uint32_t EXIT_SUCCESS on success; EXIT_FAILURE when the path is too long
+ */
+static uint32_t cache_path_of(const char* full_path, char* cache_path)
+{
+    char resolved[PATH_MAX];
+    const char* path = realpath(full_path, resolved) ? resolved : full_path;
+    const char* name = strrchr(path, PATH_SEPARATOR);
+    name = name ? name + 1 : path;
+
+    int length = snprintf(cache_path, IO_MAX_PATH_LEN, "%s%s.%016" PRIx64 "%s", AOC_INPUT_CACHE_DIR, name,
+                          cache_hash((const unsigned char*) path, strlen(path)), CACHE_EXTENSION);
+    return (length > 0 && length < IO_MAX_PATH_LEN) ? (uint32_t) EXIT_SUCCESS : (uint32_t) EXIT_FAILURE;
+}
+#endif
+
+uint32_t cache_load(const char* filename, uint32_t format, cache_t* cache)
+{
+    memset(cache, 0, sizeof(*cache));
+#ifndef CACHE_ENABLED
+    (void) filename;
+    (void) format;
+    return (uint32_t) EXIT_FAILURE;
+#else
+    /* A stream has no file to key the cache on */
+    if (io_input_is_stream())
+    {
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    char full_path[IO_MAX_PATH_LEN];
+    char cache_path[IO_MAX_PATH_LEN];
+    io_input_path(filename, full_path);
+    if (EXIT_FAILURE == cache_path_of(full_path, cache_path))
+    {
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    int fd = open(cache_path, O_RDONLY);
+    if (fd < 0)
+    {
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(cache_header_t))
+    {
+        close(fd);
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    size_t mapping_size = (size_t) st.st_size;
+    void* mapping = mmap(NULL, mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == mapping)
+    {
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    /*
+     * Size and modification time decide; only an input that was touched
+     * without changing its size is hashed to see whether it really changed.
+     */
+    const cache_header_t* header = (const cache_header_t*) mapping;
+    cache_header_t input;
+    int valid = 0 == memcmp(header->magic, CACHE_MAGIC, sizeof(header->magic)) && CACHE_VERSION == header->version &&
+                format == header->format && header->payload_size == mapping_size - sizeof(cache_header_t) &&
+                EXIT_SUCCESS == cache_describe_input(full_path, 0, &input) && input.input_size == header->input_size;
+    if (valid && (input.input_mtime_sec != header->input_mtime_sec || input.input_mtime_nsec != header->input_mtime_nsec))
+    {
+        valid = EXIT_SUCCESS == cache_describe_input(full_path, 1, &input) && input.input_hash == header->input_hash;
+    }
+    if (!valid)
+    {
+        clog_info(__FILE__, "Ignoring stale or foreign cache: %s", cache_path);
+        munmap(mapping, mapping_size);
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    clog_info(__FILE__, "Using cache: %s", cache_path);
+    cache->payload = (const char*) mapping + sizeof(cache_header_t);
+    cache->payload_size = (size_t) header->payload_size;
+    cache->mapping = mapping;
+    cache->mapping_size = mapping_size;
+    return (uint32_t) EXIT_SUCCESS;
+#endif
+}
+
+uint32_t cache_store(const char* filename, uint32_t format, const cache_section_t* sections, size_t section_count)
+{
+#ifndef CACHE_ENABLED
+    (void) filename;
+    (void) format;
+    (void) sections;
+    (void) section_count;
+    return (uint32_t) EXIT_FAILURE;
+#else
+    /* A stream has no file to key the cache on */
+    if (io_input_is_stream())
+    {
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    char full_path[IO_MAX_PATH_LEN];
+    char cache_path[IO_MAX_PATH_LEN];
+    char temp_path[IO_MAX_PATH_LEN + 4];
+    io_input_path(filename, full_path);
+    if (EXIT_FAILURE == cache_path_of(full_path, cache_path))
+    {
+        return (uint32_t) EXIT_FAILURE;
+    }
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", cache_path);
+
+    cache_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+    header.version = CACHE_VERSION;
+    header.format = format;
+    if (EXIT_FAILURE == cache_describe_input(full_path, 1, &header))
+    {
+        return (uint32_t) EXIT_FAILURE;
+    }
+    for (size_t index = 0; index < section_count; index++)
+    {
+        header.payload_size += sections[index].size;
+    }
+
+    if (0 != mkdir(AOC_INPUT_CACHE_DIR, 0755) && EEXIST != errno)
+    {
+        clog_info(__FILE__, "Cannot create cache directory: %s", AOC_INPUT_CACHE_DIR);
+        return (uint32_t) EXIT_FAILURE;
+    }
+    int fd = open(temp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        clog_info(__FILE__, "Cannot create cache: %s", temp_path);
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    uint32_t result = (uint32_t) EXIT_SUCCESS;
+    if (write(fd, &header, sizeof(header)) != (ssize_t) sizeof(header))
+    {
+        result = (uint32_t) EXIT_FAILURE;
+    }
+    for (size_t index = 0; EXIT_SUCCESS == result && index < section_count; index++)
+    {
+        const char* data = (const char*) sections[index].data;
+        size_t remaining = sections[index].size;
+        while (remaining > 0)
+        {
+            ssize_t written = write(fd, data, remaining);
+            if (written <= 0)
+            {
+                result = (uint32_t) EXIT_FAILURE;
+                break;
+            }
+            data += written;
+            remaining -= (size_t) written;
+        }
+    }
+
+    if (0 != close(fd) || EXIT_FAILURE == result || 0 != rename(temp_path, cache_path))
+    {
+        clog_error(__FILE__, "Failed to write cache: %s", cache_path);
+        unlink(temp_path);
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    clog_info(__FILE__, "Stored cache: %s", cache_path);
+    return (uint32_t) EXIT_SUCCESS;
+#endif
+}
+
+void cache_release(cache_t* cache)
+{
+    if (NULL == cache)
+    {
+        return;
+    }
+    if (cache->mapping)
+    {
+        munmap(cache->mapping, cache->mapping_size);
+    }
+    memset(cache, 0, sizeof(*cache));
+}
@@ -19,17 +19,88 @@
 
 #include "conversion.h"
 
+const uint64_t u64_powers_of_10[U64_MAX_DIGITS] = {
+    1ULL,
+    10ULL,
+    100ULL,
+    1000ULL,
+    10000ULL,
+    100000ULL,
+    1000000ULL,
+    10000000ULL,
+    100000000ULL,
+    1000000000ULL,
+    10000000000ULL,
+    100000000000ULL,
+    1000000000000ULL,
+    10000000000000ULL,
+    100000000000000ULL,
+    1000000000000000ULL,
+    10000000000000000ULL,
+    100000000000000000ULL,
+    1000000000000000000ULL,
+    10000000000000000000ULL,
+};
+
+/* "00" .. "99": the two digits of every value below 100 */
+static const char digit_pairs[200] = "00010203040506070809"
+                                     "10111213141516171819"
+                                     "20212223242526272829"
+                                     "30313233343536373839"
+                                     "40414243444546474849"
+                                     "50515253545556575859"
+                                     "60616263646566676869"
+                                     "70717273747576777879"
+                                     "80818283848586878889"
+                                     "90919293949596979899";
+
+size_t u64_to_str(uint64_t value, char* buffer)
+{
+    size_t length = u64_digit_count(value);
+    char* cursor = buffer + length;
+    *cursor = '\0';
+
+    while (value >= 100)
+    {
+        const char* pair = &digit_pairs[(value % 100) * 2];
+        value /= 100;
+        *--cursor = pair[1];
+        *--cursor = pair[0];
+    }
+    if (value >= 10)
+    {
+        *--cursor = digit_pairs[value * 2 + 1];
+        *--cursor = digit_pairs[value * 2];
+    }
+    else
+    {
+        *--cursor = (char) ('0' + value);
+    }
+    return length;
+}
+
 void long_to_str(long value, char* buffer, size_t buffersize)
 {
     if(NULL==buffer || 0 == buffersize) {
         return;
     }
 
-    int n = snprintf(buffer, buffersize, "%ld", value);
-    if (n < 0 || (size_t) n >= buffersize)
+    char digits[U64_MAX_DIGITS + 2];
+    char* text = digits + 1;
+    /* Negate in unsigned arithmetic, so LONG_MIN does not overflow */
+    size_t length = u64_to_str(value < 0 ? 0 - (uint64_t) value : (uint64_t) value, text);
+    if (value < 0)
+    {
+        *--text = '-';
+        length++;
+    }
+
+    if (length >= buffersize)
     {
-        buffer[buffersize - 1] = '\0';
+        length = buffersize - 1;
     }
+    memcpy(buffer, text, length);
+    buffer[length] = '\0';
 }
 
 int split_string(const char* src, char delim, char** left, char** right)
@@ -68,4 +139,61 @@ char* aoc_strdup(const char* s)
     if (p)
         memcpy(p, s, len);
     return p;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Check whether a character is a blank for TOKENIZER_WHITESPACE
+ */
+static inline int is_blank(char c)
+{
+    return ' ' == c || '\t' == c || '\r' == c || '\n' == c || '\v' == c || '\f' == c;
+}
+
+void tokenizer_init(tokenizer_t* tokenizer, const char* src, size_t length, char delimiter)
+{
+    /* An empty buffer has no tokens, not a single empty one */
+    tokenizer->cursor = (length > 0 || TOKENIZER_WHITESPACE == delimiter) ? src : NULL;
+    tokenizer->end = src + length;
+    tokenizer->delimiter = delimiter;
+}
+
+int tokenizer_next(tokenizer_t* tokenizer, const char** token, size_t* length)
+{
+    const char* cursor = tokenizer->cursor;
+    const char* end = tokenizer->end;
+
+    if (TOKENIZER_WHITESPACE == tokenizer->delimiter)
+    {
+        while (cursor < end && is_blank(*cursor))
+        {
+            cursor++;
+        }
+        if (cursor == end)
+        {
+            tokenizer->cursor = end;
+            return 0;
+        }
+
+        const char* token_end = cursor;
+        while (token_end < end && !is_blank(*token_end))
+        {
+            token_end++;
+        }
+        *token = cursor;
+        *length = (size_t) (token_end - cursor);
+        tokenizer->cursor = token_end;
+        return 1;
+    }
+
+    /* A NULL cursor marks that the field after the last delimiter was handed out */
+    if (NULL == cursor)
+    {
+        return 0;
+    }
+
+    const char* delimiter = memchr(cursor, tokenizer->delimiter, (size_t) (end - cursor));
+    *token = cursor;
+    *length = (size_t) ((delimiter ? delimiter : end) - cursor);
+    tokenizer->cursor = delimiter ? delimiter + 1 : NULL;
+    return 1;
+}
@@ -18,126 +18,467 @@
  *     - CLogger: For logging functionality.
  *     - Standard C Library: For input/output and standard utilities.
  *=====================================================================*/
+#include <stdlib.h>
 #include <string.h>
 
 #include "aoc.h"
+#include "cache.h"
 #include "io.h"
+#include "parallel.h"
+#include "parse.h"
+
+/* Layout tag of the cached tape: day 01, version 1 */
+#define DAY01_CACHE_FORMAT 0x0101
+
+/* Number of positions on the dial, and where it starts */
+#define DAY01_DIAL_SIZE 100
+#define DAY01_DIAL_START 50
+/* Rotations per chunk below which another thread does not pay off */
+#define DAY01_CHUNK_MIN (1u << 16)
+/* Chunks per thread, so uneven chunks balance out */
+#define DAY01_CHUNKS_PER_THREAD 4
+/* Rotations per iteration of the AVX2 kernel */
+#define DAY01_BLOCK 16
+/* Blocks after which the 32-bit lane counters are added to the totals */
+#define DAY01_FLUSH_BLOCKS (1u << 16)
+/* Laps added before dividing, so the dividend of dial_laps() stays positive */
+#define DAY01_FLOOR_BIAS 400
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DAY01_HAVE_X86 1
+#endif
 
 /**
- * @brief Solves Day 01 Part 1 of Advent of Code 2025.
- * This function reads the input data and processes it to produce
- * the result for Part 1 of Day 01.
- * @return int32_t The result of Part 1, or -EXIT_FAILURE on error.
+ * @brief The parsed rotations of the puzzle input.
+ * Every rotation is stored as signed clicks: negative for L, positive for R.
  */
-int32_t day01_part1(void) {
-    // Implementation for Day 01 Part 1
-    clog_info(__FILE__, "Entering day01_part1 function");
-    char **lines = NULL;
-    size_t line_count = 0;
+typedef struct {
+    const int16_t* rotations; /* the tape */
+    size_t count;             /* number of rotations on the tape */
+    int16_t* owned;           /* tape parsed from text (NULL when mapped from the cache) */
+    cache_t cache;            /* cache mapping the tape (when loaded from the cache) */
+} rotation_tape_t;
 
-    if(EXIT_FAILURE == io_read_input("day01.txt", &lines, &line_count)) {
-        return -EXIT_FAILURE;
+/**
+ * @brief Parse the rotation of a line like "L68".
+ * @param line     The line view to parse
+ * @param rotation The signed rotation
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE when the line is
+ *         not a rotation or the rotation does not fit the tape.
+ */
+static uint32_t parse_rotation(const io_line_t* line, int16_t* rotation)
+{
+    size_t length = line->length;
+    if (length > 0 && '\r' == line->data[length - 1])
+    {
+        length--; /* a '\r' of a CRLF file */
+    }
+
+    uint32_t value = 0;
+    if (length < 2 || ('L' != line->data[0] && 'R' != line->data[0]) ||
+        length - 1 != parse_u32(line->data + 1, length - 1, &value))
+    {
+        clog_error(__FILE__, "Not a rotation: %.*s", (int) line->length, line->data);
+        return (uint32_t) EXIT_FAILURE;
+    }
+    if (value > INT16_MAX)
+    {
+        clog_error(__FILE__, "Rotation %.*s does not fit the tape", (int) line->length, line->data);
+        return (uint32_t) EXIT_FAILURE;
     }
 
-    int32_t dail = 50;
-    size_t index = 0;
-    size_t password = 0;
+    *rotation = ('L' == line->data[0]) ? -(int16_t) value : (int16_t) value;
+    return (uint32_t) EXIT_SUCCESS;
+}
 
-    while(index < line_count) {
-        if (strncmp(lines[index], "L", 1) == 0)
+/**
+ * @brief Load the rotation tape.
+ * The tape is mapped from the .aocbin cache when it is still valid.
+ * Otherwise the input is streamed, parsed and the tape is cached.
+ * @param tape The tape to fill
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
+ */
+static uint32_t rotation_tape_load(rotation_tape_t* tape)
+{
+    memset(tape, 0, sizeof(*tape));
+    if (EXIT_SUCCESS == cache_load("day01.txt", DAY01_CACHE_FORMAT, &tape->cache))
+    {
+        tape->rotations = (const int16_t*) tape->cache.payload;
+        tape->count = tape->cache.payload_size / sizeof(int16_t);
+        return (uint32_t) EXIT_SUCCESS;
+    }
+
+    io_line_reader_t reader;
+    io_line_t line;
+    if (EXIT_FAILURE == io_reader_open("day01.txt", &reader))
+    {
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    size_t capacity = 1024;
+    tape->owned = malloc(capacity * sizeof(int16_t));
+    int failed = (NULL == tape->owned);
+    while (!failed && io_reader_next(&reader, &line))
+    {
+        if (tape->count == capacity)
         {
-            dail = dail - atoi(&lines[index][1]) + 100;
+            capacity *= 2;
+            int16_t* tmp = realloc(tape->owned, capacity * sizeof(int16_t));
+            if (!tmp)
+            {
+                failed = 1;
+                break;
+            }
+            tape->owned = tmp;
         }
-        else {
-            dail += atoi(&lines[index][1]);
+        if (EXIT_FAILURE == parse_rotation(&line, &tape->owned[tape->count]))
+        {
+            failed = 1;
+            break;
         }
+        tape->count++;
+    }
 
-        dail %= 100;
-        if (dail == 0) {
-            password++;
-        }
+    failed |= reader.error;
+    io_reader_close(&reader);
+    if (failed)
+    {
+        free(tape->owned);
+        memset(tape, 0, sizeof(*tape));
+        return (uint32_t) EXIT_FAILURE;
+    }
 
-        clog_debug(__FILE__, "The dail is rotated %s to point at %d", lines[index], dail);
-        index++;
+    tape->rotations = tape->owned;
+    cache_section_t section = {tape->owned, tape->count * sizeof(int16_t)};
+    cache_store("day01.txt", DAY01_CACHE_FORMAT, &section, 1);
+    return (uint32_t) EXIT_SUCCESS;
+}
+
+/**
+ * @brief Release a tape loaded by rotation_tape_load().
+ * @param tape The tape to release
+ */
+static void rotation_tape_free(rotation_tape_t* tape)
+{
+    free(tape->owned);
+    cache_release(&tape->cache);
+    memset(tape, 0, sizeof(*tape));
+}
+
+/**
+ * @brief Floor of x / 100 for the dial positions of a single rotation.
+ * The bias keeps the dividend positive (|x| stays below a rotation plus
+ * one lap), so the division by a constant compiles to a multiplication.
+ */
+static inline int32_t dial_laps(int32_t x)
+{
+    return (x + DAY01_DIAL_SIZE * DAY01_FLOOR_BIAS) / DAY01_DIAL_SIZE - DAY01_FLOOR_BIAS;
+}
+
+/**
+ * @brief Follow the dial over a stretch of the tape, one rotation at a time.
+ * With the unwrapped position a before and b after a rotation, turning
+ * right reaches 0 floor(b / 100) - floor(a / 100) times; turning left it
+ * is floor((a - 1) / 100) - floor((b - 1) / 100). Both are
+ * |floor((b - s) / 100) - floor((a - s) / 100)| with s = 1 for a left
+ * turn, so a step needs no branches.
+ * @param rotations The rotations
+ * @param count     Number of rotations
+ * @param dail      Position of the dial before the first rotation
+ * @param stops     Incremented for every rotation that ends at 0
+ * @param hits      Incremented for every click that reaches 0
+ * @return int32_t Position of the dial after the last rotation
+ */
+static int32_t rotation_scan_scalar(const int16_t* rotations, size_t count, int32_t dail, uint64_t* stops,
+                                    uint64_t* hits)
+{
+    for (size_t index = 0; index < count; index++)
+    {
+        int32_t rotation = rotations[index];
+        int32_t after = dail + rotation;
+        int32_t shift = rotation < 0;
+        *hits += (uint64_t) abs(dial_laps(after - shift) - dial_laps(dail - shift));
+        dail = after - DAY01_DIAL_SIZE * dial_laps(after);
+        *stops += (0 == dail);
     }
+    return dail;
+}
 
-    free(lines);
-    return password;
+#ifdef DAY01_HAVE_X86
+/**
+ * @brief Inclusive prefix sum of 8 int32 lanes.
+ */
+__attribute__((target("avx2"))) static inline __m256i rotation_prefix_avx2(__m256i x)
+{
+    x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+    x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+    /* The shifts stay within 128-bit halves: carry the low half's total into the high half */
+    __m256i low_total = _mm256_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm256_add_epi32(x, _mm256_permute2x128_si256(low_total, low_total, 0x08));
 }
+
 /**
- * @brief Solves Day 01 Part 2 of Advent of Code 2025.
- * This function reads the input data and processes it to produce
- * the result for Part 2 of Day 01.
- * @return int32_t The result of Part 2, or -EXIT_FAILURE on error.
+ * @brief floor(x / 100) per int32 lane, through float.
+ * (x + 0.5) / 100 is at least 0.005 away from an integer, far more than
+ * the float rounding error while |x| stays below 2^20.
  */
-int32_t day01_part2(void)
+__attribute__((target("avx2"))) static inline __m256i rotation_laps_avx2(__m256i x)
 {
-    // Implementation for Day 01 Part 2
-    clog_info(__FILE__, "Entering day01_part2 function");
-    char** lines = NULL;
-    size_t line_count = 0;
+    __m256 quotient = _mm256_mul_ps(_mm256_add_ps(_mm256_cvtepi32_ps(x), _mm256_set1_ps(0.5f)),
+                                    _mm256_set1_ps(1.0f / DAY01_DIAL_SIZE));
+    return _mm256_cvttps_epi32(_mm256_floor_ps(quotient));
+}
+
+/**
+ * @brief Count the hits and stops of 8 rotations.
+ * @param rotation The rotations, widened to int32
+ * @param after    Unwrapped dial position after every rotation
+ * @param hits     Per-lane hit counters (updated)
+ * @param stops    Per-lane stop counters (updated)
+ */
+__attribute__((target("avx2"))) static inline void rotation_count_avx2(__m256i rotation, __m256i after,
+                                                                      __m256i* hits, __m256i* stops)
+{
+    __m256i before = _mm256_sub_epi32(after, rotation);
+    __m256i shift = _mm256_srli_epi32(rotation, 31);
+    __m256i laps = _mm256_sub_epi32(rotation_laps_avx2(_mm256_sub_epi32(after, shift)),
+                                    rotation_laps_avx2(_mm256_sub_epi32(before, shift)));
+    *hits = _mm256_add_epi32(*hits, _mm256_abs_epi32(laps));
+
+    __m256i at = _mm256_mullo_epi32(rotation_laps_avx2(after), _mm256_set1_epi32(DAY01_DIAL_SIZE));
+    *stops = _mm256_sub_epi32(*stops, _mm256_cmpeq_epi32(at, after));
+}
 
-    if (EXIT_FAILURE == io_read_input("day01.txt", &lines, &line_count))
+/**
+ * @brief Add the lanes of a counter to a total and clear it.
+ */
+__attribute__((target("avx2"))) static inline void rotation_flush_avx2(__m256i* counter, uint64_t* total)
+{
+    uint32_t lanes[8];
+    _mm256_storeu_si256((__m256i*) lanes, *counter);
+    for (int lane = 0; lane < 8; lane++)
     {
-        return -EXIT_FAILURE;
+        *total += lanes[lane];
     }
+    *counter = _mm256_setzero_si256();
+}
 
-    int32_t dail = 50;
-    size_t index = 0;
-    size_t password = 0;
-    int32_t rotate=0;
-    size_t overflow = 0;
+/**
+ * @brief rotation_scan_scalar(), DAY01_BLOCK rotations per iteration.
+ * The positions of a block come from a prefix sum of its rotations on
+ * top of the position before it; that position is kept in a vector and
+ * wrapped to [0, 100) once per block, so no lane leaves the vector.
+ */
+__attribute__((target("avx2"))) static int32_t rotation_scan_avx2(const int16_t* rotations, size_t count,
+                                                                  int32_t dail, uint64_t* stops, uint64_t* hits)
+{
+    const __m256i last = _mm256_set1_epi32(7);
+    const __m256i size = _mm256_set1_epi32(DAY01_DIAL_SIZE);
+    __m256i base = _mm256_set1_epi32(dail);
+    __m256i hit_lanes = _mm256_setzero_si256();
+    __m256i stop_lanes = _mm256_setzero_si256();
+    size_t blocks = count / DAY01_BLOCK;
 
-    while (index < line_count)
+    for (size_t block = 0; block < blocks; block++)
     {
-        rotate = atoi(&lines[index][1]);
+        __m256i tape = _mm256_loadu_si256((const __m256i*) (rotations + block * DAY01_BLOCK));
+        __m256i low = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(tape));
+        __m256i high = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(tape, 1));
 
-        if(rotate > 100) {
-            overflow = (rotate / 100);
-            rotate = rotate % 100;
-        }
+        __m256i after_low = _mm256_add_epi32(base, rotation_prefix_avx2(low));
+        __m256i after_high =
+            _mm256_add_epi32(_mm256_permutevar8x32_epi32(after_low, last), rotation_prefix_avx2(high));
+        rotation_count_avx2(low, after_low, &hit_lanes, &stop_lanes);
+        rotation_count_avx2(high, after_high, &hit_lanes, &stop_lanes);
 
-        if(strncmp(lines[index], "L", 1) == 0)
-        {
-            if(dail ==0 ) {
-                dail = 100 - rotate;
-            }
-            else {
-                dail = dail - rotate;
-                if(dail < 0) {
-                    dail += 100;
-                    overflow += 1;
-                }
-                else if (dail == 0) {
-                    overflow +=1;
-                }
-            }
-        }
-        else {
-            dail += rotate;
-            if (dail == 0)
-            {
-                password += 1;
-            }
-            if (dail >= 100)
-            {
-                dail %= 100;
-                overflow += 1;
-            }
-        }
+        base = _mm256_permutevar8x32_epi32(after_high, last);
+        base = _mm256_sub_epi32(base, _mm256_mullo_epi32(rotation_laps_avx2(base), size));
 
-        password += overflow;
-        if (overflow > 0)
+        if (0 == (block + 1) % DAY01_FLUSH_BLOCKS)
         {
-            clog_debug(__FILE__, "The dail is rotated %s to point at %d; during the rotation, it points to 0 %d times; password: %d", lines[index], dail, overflow, password);
+            rotation_flush_avx2(&hit_lanes, hits);
+            rotation_flush_avx2(&stop_lanes, stops);
         }
-        else
-            clog_debug(__FILE__, "The dail is rotated %s to point at %d; password: %d", lines[index], dail, password);
+    }
+    rotation_flush_avx2(&hit_lanes, hits);
+    rotation_flush_avx2(&stop_lanes, stops);
+
+    dail = _mm256_cvtsi256_si32(base);
+    return rotation_scan_scalar(rotations + blocks * DAY01_BLOCK, count - blocks * DAY01_BLOCK, dail, stops, hits);
+}
+#endif
+
+/**
+ * @brief Follow the dial over a stretch of the tape (AVX2 when available).
+ * @return int32_t Position of the dial after the last rotation
+ */
+static int32_t rotation_scan(const int16_t* rotations, size_t count, int32_t dail, uint64_t* stops, uint64_t* hits)
+{
+#ifdef DAY01_HAVE_X86
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return rotation_scan_avx2(rotations, count, dail, stops, hits);
+    }
+#endif
+    return rotation_scan_scalar(rotations, count, dail, stops, hits);
+}
+
+/**
+ * @brief The tape cut into chunks for the parallel scan.
+ */
+typedef struct {
+    const int16_t* rotations;
+    size_t count;
+    size_t chunks;
+    int32_t* offsets; /* net rotation per chunk, later the start position per chunk */
+    uint64_t* stops;  /* rotations that end at 0, per chunk */
+    uint64_t* hits;   /* clicks that reach 0, per chunk */
+} rotation_chunks_t;
+
+/**
+ * @brief First pass: the net rotation of a chunk, which does not depend on its start.
+ */
+static void rotation_chunk_offset(size_t chunk, void* context)
+{
+    const rotation_chunks_t* work = (const rotation_chunks_t*) context;
+    size_t first = work->count * chunk / work->chunks;
+    size_t last = work->count * (chunk + 1) / work->chunks;
+    int64_t offset = 0;
+    for (size_t index = first; index < last; index++)
+    {
+        offset += work->rotations[index];
+    }
+    work->offsets[chunk] = (int32_t) ((offset % DAY01_DIAL_SIZE + DAY01_DIAL_SIZE) % DAY01_DIAL_SIZE);
+}
+
+/**
+ * @brief Second pass: follow the dial over a chunk from its known start.
+ */
+static void rotation_chunk_scan(size_t chunk, void* context)
+{
+    const rotation_chunks_t* work = (const rotation_chunks_t*) context;
+    size_t first = work->count * chunk / work->chunks;
+    size_t last = work->count * (chunk + 1) / work->chunks;
+    work->stops[chunk] = 0;
+    work->hits[chunk] = 0;
+    rotation_scan(work->rotations + first, last - first, work->offsets[chunk], &work->stops[chunk],
+                  &work->hits[chunk]);
+}
+
+/**
+ * @brief Count how often the dial ends at 0 and how often it passes 0.
+ * A parallel prefix scan: the chunks of the tape sum their rotations on
+ * all threads, a scan over those sums gives every chunk its start
+ * position, and then every chunk is followed on its own thread.
+ * @param stops Number of rotations that end at 0 (part 1)
+ * @param hits  Number of clicks that reach 0 (part 2)
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
+ */
+static uint32_t rotation_count_zeros(uint64_t* stops, uint64_t* hits)
+{
+    rotation_tape_t tape;
+    if (EXIT_FAILURE == rotation_tape_load(&tape))
+    {
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    *stops = 0;
+    *hits = 0;
+    unsigned threads = parallel_thread_count();
+    size_t chunks = tape.count / DAY01_CHUNK_MIN;
+    if (chunks > (size_t) threads * DAY01_CHUNKS_PER_THREAD)
+    {
+        chunks = (size_t) threads * DAY01_CHUNKS_PER_THREAD;
+    }
+    if (chunks < 2)
+    {
+        rotation_scan(tape.rotations, tape.count, DAY01_DIAL_START, stops, hits);
+        rotation_tape_free(&tape);
+        return (uint32_t) EXIT_SUCCESS;
+    }
+
+    rotation_chunks_t work = {tape.rotations, tape.count, chunks, malloc(chunks * sizeof(int32_t)),
+                              malloc(chunks * sizeof(uint64_t)), malloc(chunks * sizeof(uint64_t))};
+    if (!work.offsets || !work.stops || !work.hits)
+    {
+        free(work.offsets);
+        free(work.stops);
+        free(work.hits);
+        rotation_tape_free(&tape);
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    parallel_for(chunks, threads, rotation_chunk_offset, &work);
+    int32_t dail = DAY01_DIAL_START;
+    for (size_t chunk = 0; chunk < chunks; chunk++)
+    {
+        int32_t offset = work.offsets[chunk];
+        work.offsets[chunk] = dail;
+        dail = (dail + offset) % DAY01_DIAL_SIZE;
+    }
+    parallel_for(chunks, threads, rotation_chunk_scan, &work);
+
+    for (size_t chunk = 0; chunk < chunks; chunk++)
+    {
+        *stops += work.stops[chunk];
+        *hits += work.hits[chunk];
+    }
+
+    free(work.offsets);
+    free(work.stops);
+    free(work.hits);
+    rotation_tape_free(&tape);
+    return (uint32_t) EXIT_SUCCESS;
+}
+
+/**
+ * @brief Count the zeros of a rotation tape with the scalar scan only.
+ * Scans the whole tape from DAY01_DIAL_START in one go, without chunks,
+ * threads or AVX2, so the tests can check the fast path against it.
+ * @param rotations The rotations
+ * @param count     Number of rotations
+ * @param stops     Set to the number of rotations that end at 0
+ * @param hits      Set to the number of clicks that reach 0
+ */
+void day01_count_zeros_scalar(const int16_t* rotations, size_t count, uint64_t* stops, uint64_t* hits)
+{
+    *stops = 0;
+    *hits = 0;
+    rotation_scan_scalar(rotations, count, DAY01_DIAL_START, stops, hits);
+}
+
+/**
+ * @brief Solves Day 01 Part 1 of Advent of Code 2025.
+ * This function reads the input data and processes it to produce
+ * the result for Part 1 of Day 01.
+ * @return uint64_t The result of Part 1, or -EXIT_FAILURE on error.
+ */
+uint64_t day01_part1(void) {
+    // Implementation for Day 01 Part 1
+    clog_info(__FILE__, "Entering day01_part1 function");
+    uint64_t stops, hits;
 
-        overflow = 0;
-        index++;
+    if(EXIT_FAILURE == rotation_count_zeros(&stops, &hits)) {
+        return -EXIT_FAILURE;
     }
+    return stops;
+}
+/**
+ * @brief Solves Day 01 Part 2 of Advent of Code 2025.
+ * This function reads the input data and processes it to produce
+ * the result for Part 2 of Day 01.
+ * @return uint64_t The result of Part 2, or -EXIT_FAILURE on error.
+ */
+uint64_t day01_part2(void)
+{
+    // Implementation for Day 01 Part 2
+    clog_info(__FILE__, "Entering day01_part2 function");
+    uint64_t stops, hits;
 
-    free(lines);
-    return password;
-}
\ No newline at end of file
+    if (EXIT_FAILURE == rotation_count_zeros(&stops, &hits))
+    {
+        return -EXIT_FAILURE;
+    }
+    return hits;
+}
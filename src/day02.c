@@ -24,147 +24,451 @@
 #include "aoc.h"
 #include "io.h"
 #include "conversion.h"
+#include "interval.h"
+#include "parallel.h"
+#include "parse.h"
 
 #define clog_debug(...) {}
 
-#define MAX_CHAR_LENGTH_UINT64_T 20 
+/*
+ * With AOC_DAY02_BRUTE_FORCE the parts check every ID of every range one
+ * by one (the original solution, spread over all threads) instead of
+ * summing the invalid IDs in closed form. The brute force is always
+ * built: the tests cross-check it against the closed form.
+ */
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DAY02_HAVE_X86 1
+#endif
 
-uint64_t return_value_if_invalid_id(uint64_t id) {
+/* IDs checked per step by the AVX2 batch check */
+#define DAY02_BATCH 4
 
-    char* value = malloc(sizeof(char) * MAX_CHAR_LENGTH_UINT64_T);
-    long_to_str(id, value, MAX_CHAR_LENGTH_UINT64_T);
-    size_t length = strlen(value);
-    if (0!=(length & 1))
+/**
+ * @brief Repunit divisors of the IDs of one digit length.
+ * An ID of `length` digits repeats a block of d digits exactly when it
+ * is a multiple of R = 1 + 10^d + 10^(2d) + ... Every period divides
+ * length / q for some prime factor q of length, so only those periods
+ * need checking; for an even length the first one is the half (q = 2).
+ */
+typedef struct {
+    unsigned count;
+    uint64_t divisors[2];
+} day02_repunits_t;
+
+static const day02_repunits_t day02_repunits[U64_MAX_DIGITS + 1] = {
+    {0, {0, 0}},                                   /*  0 */
+    {0, {0, 0}},                                   /*  1 */
+    {1, {11ULL, 0}},                               /*  2 */
+    {1, {111ULL, 0}},                              /*  3 */
+    {1, {101ULL, 0}},                              /*  4 */
+    {1, {11111ULL, 0}},                            /*  5 */
+    {2, {1001ULL, 10101ULL}},                      /*  6 */
+    {1, {1111111ULL, 0}},                          /*  7 */
+    {1, {10001ULL, 0}},                            /*  8 */
+    {1, {1001001ULL, 0}},                          /*  9 */
+    {2, {100001ULL, 101010101ULL}},                /* 10 */
+    {1, {11111111111ULL, 0}},                      /* 11 */
+    {2, {1000001ULL, 100010001ULL}},               /* 12 */
+    {1, {1111111111111ULL, 0}},                    /* 13 */
+    {2, {10000001ULL, 1010101010101ULL}},          /* 14 */
+    {2, {10000100001ULL, 1001001001001ULL}},       /* 15 */
+    {1, {100000001ULL, 0}},                        /* 16 */
+    {1, {11111111111111111ULL, 0}},                /* 17 */
+    {2, {1000000001ULL, 1000001000001ULL}},        /* 18 */
+    {1, {1111111111111111111ULL, 0}},              /* 19 */
+    {2, {10000000001ULL, 10001000100010001ULL}},   /* 20 */
+};
+
+uint64_t return_value_if_invalid_id(uint64_t id)
+{
+    unsigned length = u64_digit_count(id);
+    if (0 != (length & 1))
     {
         // uneven length is always valid
         return 0;
     }
 
-    char *left = malloc(sizeof(char) * MAX_CHAR_LENGTH_UINT64_T),
-         *right = malloc(sizeof(char) * MAX_CHAR_LENGTH_UINT64_T);
+    uint64_t half = u64_pow10(length / 2);
+    return (id / half == id % half) ? id : 0;
+}
 
-    strncpy(left, value, (length / 2));
-    strncpy(right, value + (length/2), length / 2);
-    left[(length / 2)] = '\0';
-    right[(length / 2)] = '\0';
-    clog_debug(__FILE__, "left: %s; right: %s", left, right);
+uint64_t return_value_if_invalid_id_part2(uint64_t id)
+{
+    const day02_repunits_t* repunits = &day02_repunits[u64_digit_count(id)];
+    for (unsigned index = 0; index < repunits->count; index++)
+    {
+        if (0 == id % repunits->divisors[index])
+        {
+            return id;
+        }
+    }
+    return 0;
+}
 
-    if (strcmp(left, right)==0)
+#ifdef DAY02_HAVE_X86
+/**
+ * @brief Get the inverse of an odd divisor modulo 2^64 (Newton's method).
+ * Then id is a multiple of divisor exactly when id * inverse (mod 2^64)
+ * is at most UINT64_MAX / divisor, which needs no division.
+ */
+static uint64_t day02_inverse(uint64_t divisor)
+{
+    uint64_t inverse = divisor; /* correct in the low 3 bits, doubling per step */
+    for (int step = 0; step < 5; step++)
     {
-        free(left); 
-        free(right);
-        free(value);
-        return id;
+        inverse *= 2 - divisor * inverse;
     }
-    free(left);
-    free(right);
-    free(value);
-    return 0; 
+    return inverse;
 }
 
-#define TRUE 1
-#define FALSE 0
+/**
+ * @brief Low 64 bits of a 64x64-bit product per lane (AVX2 only multiplies 32-bit halves).
+ */
+__attribute__((target("avx2"))) static inline __m256i day02_mullo_avx2(__m256i left, __m256i right)
+{
+    __m256i low = _mm256_mul_epu32(left, right);
+    __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(left, 32), right),
+                                     _mm256_mul_epu32(left, _mm256_srli_epi64(right, 32)));
+    return _mm256_add_epi64(low, _mm256_slli_epi64(cross, 32));
+}
 
-uint64_t return_value_if_invalid_id_part2(uint64_t id)
+/**
+ * @brief Sum the invalid IDs of [from, to], all of one digit length, DAY02_BATCH at a time.
+ * @param from       first ID
+ * @param to         last ID
+ * @param repunits   divisors to test: 1 for part 1, all for part 2
+ * @param count      number of divisors
+ * @return uint64_t sum of the IDs that are a multiple of one of the divisors
+ */
+__attribute__((target("avx2"))) static uint64_t day02_batch_sum_avx2(uint64_t from, uint64_t to,
+                                                                    const uint64_t* repunits, unsigned count)
 {
+    /* With a single divisor the second test repeats the first */
+    uint64_t first = repunits[0];
+    uint64_t second = count > 1 ? repunits[1] : first;
+    const __m256i sign = _mm256_set1_epi64x((long long) 0x8000000000000000ULL);
+    const __m256i inverse0 = _mm256_set1_epi64x((long long) day02_inverse(first));
+    const __m256i inverse1 = _mm256_set1_epi64x((long long) day02_inverse(second));
+    /* Unsigned compares as signed ones on sign-flipped values */
+    const __m256i limit0 = _mm256_set1_epi64x((long long) ((UINT64_MAX / first) ^ 0x8000000000000000ULL));
+    const __m256i limit1 = _mm256_set1_epi64x((long long) ((UINT64_MAX / second) ^ 0x8000000000000000ULL));
+    const __m256i step = _mm256_set1_epi64x(DAY02_BATCH);
+
+    /* A segment never spans all 2^64 IDs, so the count fits */
+    uint64_t total = to - from + 1;
+    __m256i ids = _mm256_add_epi64(_mm256_set1_epi64x((long long) from), _mm256_set_epi64x(3, 2, 1, 0));
+    __m256i sums = _mm256_setzero_si256();
+    for (uint64_t batch = 0; batch < total / DAY02_BATCH; batch++)
+    {
+        __m256i miss0 = _mm256_cmpgt_epi64(_mm256_xor_si256(day02_mullo_avx2(ids, inverse0), sign), limit0);
+        __m256i miss1 = _mm256_cmpgt_epi64(_mm256_xor_si256(day02_mullo_avx2(ids, inverse1), sign), limit1);
+        sums = _mm256_add_epi64(sums, _mm256_andnot_si256(_mm256_and_si256(miss0, miss1), ids));
+        ids = _mm256_add_epi64(ids, step);
+    }
+
+    uint64_t lanes[DAY02_BATCH];
+    _mm256_storeu_si256((__m256i*) lanes, sums);
+    uint64_t sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    uint64_t id = from + total / DAY02_BATCH * DAY02_BATCH;
+    for (uint64_t remaining = total % DAY02_BATCH; remaining > 0; remaining--, id++)
+    {
+        sum += (0 == id % first || 0 == id % second) ? id : 0;
+    }
+    return sum;
+}
+#endif
+
+/**
+ * @brief Sum the invalid IDs of [from, to], all of one digit length.
+ * Uses the AVX2 batch check when the CPU has it, else checks one ID at a time.
+ */
+static uint64_t day02_segment_sum(uint64_t from, uint64_t to, int any_repeat)
+{
+    const day02_repunits_t* repunits = &day02_repunits[u64_digit_count(from)];
+    unsigned count = any_repeat ? repunits->count : (0 == (u64_digit_count(from) & 1));
+    if (0 == count)
+    {
+        return 0;
+    }
+
+#ifdef DAY02_HAVE_X86
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return day02_batch_sum_avx2(from, to, repunits->divisors, count);
+    }
+#endif
+    uint64_t sum = 0;
+    for (uint64_t id = from;; id++)
+    {
+        sum += any_repeat ? return_value_if_invalid_id_part2(id) : return_value_if_invalid_id(id);
+        if (id == to)
+        {
+            break;
+        }
+    }
+    return sum;
+}
+
+/* Shards per thread: parallel_for() hands them out dynamically, so a
+ * slow shard (more digits per ID) does not hold up the others */
+#define DAY02_SHARDS_PER_THREAD 4
+
+/**
+ * @brief The ID ranges of the input, split into shards of equal ID count.
+ * The IDs of all ranges are numbered consecutively; shard s checks IDs
+ * [total * s / shards, total * (s + 1) / shards) of that numbering, so a
+ * single huge range is spread over all shards.
+ */
+typedef struct {
+    const range_t* ranges;
+    const uint64_t* offsets; /* offsets[i] = number of IDs before range i; offsets[count] = total */
+    size_t count;
+    size_t shards;
+    int any_repeat;
+    uint64_t* sums;          /* private sum per shard, reduced by the caller */
+} day02_shards_t;
 
-    char* value = malloc(sizeof(char) * MAX_CHAR_LENGTH_UINT64_T);
-    long_to_str(id, value, MAX_CHAR_LENGTH_UINT64_T);
-    size_t length = strlen(value);
+/**
+ * @brief Get the first ID number of a shard (total IDs for shard == shards)
+ */
+static uint64_t day02_shard_bound(const day02_shards_t* work, size_t shard)
+{
+    return (uint64_t) ((__uint128_t) work->offsets[work->count] * shard / work->shards);
+}
 
-    char *chunk_value;
-    uint8_t value_is_invalid = TRUE;
+/**
+ * @brief Brute-force one shard: check each of its IDs.
+ * @param shard   Index of the shard
+ * @param context The day02_shards_t
+ */
+static void day02_shard(size_t shard, void* context)
+{
+    const day02_shards_t* work = (const day02_shards_t*) context;
+    uint64_t first = day02_shard_bound(work, shard);
+    uint64_t last = day02_shard_bound(work, shard + 1);
+    if (first == last)
+    {
+        work->sums[shard] = 0;
+        return;
+    }
 
-    for(size_t chunk_size=1; chunk_size <= (length/2); chunk_size++) {
+    /* The range holding the first ID: the last one with offsets[range] <= first */
+    size_t low = 0, high = work->count;
+    while (high - low > 1)
+    {
+        size_t middle = low + (high - low) / 2;
+        if (work->offsets[middle] <= first)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
 
-        chunk_value = value;
-        value_is_invalid = TRUE;
-        while(chunk_value!=NULL && chunk_value < (value + length)) {
-            if (0 != strncmp(value, chunk_value, chunk_size)) {
-                value_is_invalid = FALSE;
+    uint64_t sum = 0;
+    for (size_t range = low; range < work->count && work->offsets[range] < last; range++)
+    {
+        uint64_t skip = first > work->offsets[range] ? first - work->offsets[range] : 0;
+        uint64_t end = last < work->offsets[range + 1] ? last : work->offsets[range + 1];
+        uint64_t from = work->ranges[range].start + skip;
+        uint64_t to = work->ranges[range].start + (end - work->offsets[range]) - 1;
+        /* One segment per digit length, as the divisors depend on it */
+        for (;;)
+        {
+            unsigned length = u64_digit_count(from);
+            uint64_t segment_end = (length < U64_MAX_DIGITS && to > u64_pow10(length) - 1) ? u64_pow10(length) - 1 : to;
+            sum += day02_segment_sum(from, segment_end, work->any_repeat);
+            if (segment_end == to)
+            {
                 break;
             }
-            chunk_value += chunk_size;
+            from = segment_end + 1;
         }
-        if(value_is_invalid == TRUE) {
-            free(value);
-            return id;
+    }
+    /* Written once at the end, so the shards do not share a cache line while they run */
+    work->sums[shard] = sum;
+}
+
+uint64_t day02_brute_force_sum(const range_t* ranges, size_t count, int any_repeat)
+{
+    uint64_t* offsets = malloc((count + 1) * sizeof(uint64_t));
+    if (!offsets)
+    {
+        return -EXIT_FAILURE;
+    }
+    offsets[0] = 0;
+    for (size_t range = 0; range < count; range++)
+    {
+        uint64_t ids = ranges[range].end_including - ranges[range].start + 1;
+        if (offsets[range] + ids < offsets[range])
+        {
+            clog_error(__FILE__, "Too many IDs to check one by one");
+            free(offsets);
+            return -EXIT_FAILURE;
         }
+        offsets[range + 1] = offsets[range] + ids;
     }
 
-    return 0;
+    unsigned threads = parallel_thread_count();
+    size_t shards = (size_t) threads * DAY02_SHARDS_PER_THREAD;
+    if (shards > offsets[count])
+    {
+        shards = offsets[count] > 0 ? (size_t) offsets[count] : 1;
+    }
+    uint64_t* sums = malloc(shards * sizeof(uint64_t));
+    if (!sums)
+    {
+        free(offsets);
+        return -EXIT_FAILURE;
+    }
+
+    day02_shards_t work = {ranges, offsets, count, shards, any_repeat, sums};
+    parallel_for(shards, threads, day02_shard, &work);
+
+    uint64_t result = 0;
+    for (size_t shard = 0; shard < shards; shard++)
+    {
+        result += sums[shard];
+    }
+    free(sums);
+    free(offsets);
+    return result;
 }
 
+#ifndef AOC_DAY02_BRUTE_FORCE
 /**
- * @brief Solves Day 02 Part 1 of Advent of Code 2025.
- * This function reads the input data and processes it to produce
- * the result for Part 1 of Day 02.
- * @return uint64_t The result of Part 1, or -EXIT_FAILURE on error.
+ * @brief Möbius function of a small positive number
+ * @return int 0 when n has a squared prime factor, else (-1)^(number of prime factors)
  */
-uint64_t
-day02_part1(void)
+static int mobius(unsigned n)
 {
-    // Implementation for Day 01 Part 1
-    clog_info(__FILE__, "Entering day02_part1 function");
-    char** lines = NULL;
-    size_t line_count = 0;
+    int result = 1;
+    for (unsigned prime = 2; prime * prime <= n; prime++)
+    {
+        if (0 == n % prime)
+        {
+            n /= prime;
+            if (0 == n % prime)
+            {
+                return 0;
+            }
+            result = -result;
+        }
+    }
+    return n > 1 ? -result : result;
+}
 
-    if (EXIT_FAILURE == io_read_input("day02.txt", &lines, &line_count))
+/**
+ * @brief Sum the IDs of `length` digits that repeat a block of `period` digits
+ * Such IDs are p * R with R = 1 + 10^period + 10^(2*period) + ... (e.g.
+ * 1001 or 10101) and p any block without a leading zero, so the IDs in
+ * [first, last] are an arithmetic series in p. The sum is computed
+ * modulo 2^64, which keeps inclusion-exclusion exact as long as the
+ * final answer fits.
+ *
+ * @param first  lowest ID, with `length` digits
+ * @param last   highest ID, with `length` digits
+ * @param length number of digits of the IDs
+ * @param period number of digits of the repeated block, dividing length
+ * @return uint64_t sum of the repeated-block IDs in [first, last]
+ */
+static uint64_t repeated_id_sum(uint64_t first, uint64_t last, unsigned length, unsigned period)
+{
+    uint64_t repunit = 0;
+    for (unsigned shift = 0; shift < length; shift += period)
     {
-        return -EXIT_FAILURE;
+        repunit += u64_pow10(shift);
     }
 
-    char *line = lines[0];
+    uint64_t low = first / repunit + (0 != first % repunit);
+    uint64_t high = last / repunit;
+    if (low < u64_pow10(period - 1))
+    {
+        low = u64_pow10(period - 1);
+    }
+    if (high > u64_pow10(period) - 1)
+    {
+        high = u64_pow10(period) - 1;
+    }
+    if (low > high)
+    {
+        return 0;
+    }
 
-    char *start = NULL, *end = NULL;
-    uint64_t result = 0;
+    /* (low + high) * count / 2: exactly one of the two factors is even */
+    uint64_t count = high - low + 1;
+    uint64_t total = low + high;
+    uint64_t blocks = (0 == (count & 1)) ? (count / 2) * total : (total / 2) * count;
+    return blocks * repunit;
+}
 
-    char* id_range = strtok(line, ",");
-    while (id_range != NULL) {
-        if (EXIT_SUCCESS == split_string(id_range, '-', &start, &end)) {
-            clog_debug(__FILE__, "start: %s; end: %s", start, end);
-        }
-        else {
-            clog_debug(__FILE__, "Error parsing %s", id_range);
-        }
+/**
+ * @brief Sum the invalid IDs in [first, last] without visiting them
+ * Handles every digit length in the range separately. For part 1 an ID
+ * is invalid when it is a block repeated twice. For part 2 any repeat
+ * counts: an ID of `length` digits with period d also has every period
+ * that is a multiple of d, so the union over the proper divisors of
+ * length is summed by inclusion-exclusion with Möbius weights. The cost
+ * is O(digits^2) per range, whatever its width.
+ *
+ * @param first      first ID of the range
+ * @param last       last ID of the range (inclusive)
+ * @param any_repeat 0 for part 1 (exactly two repeats), else part 2
+ * @return uint64_t Sum of the invalid IDs
+ */
+static uint64_t invalid_id_sum(uint64_t first, uint64_t last, int any_repeat)
+{
+    uint64_t result = 0;
+    if (first > last)
+    {
+        return 0;
+    }
 
-        // First check to see if the first value is correct
-        if(start[0] >= '1' && start[0] <= '9') {
+    for (unsigned length = u64_digit_count(first); length <= u64_digit_count(last); length++)
+    {
+        uint64_t low = first > u64_pow10(length - 1) ? first : u64_pow10(length - 1);
+        uint64_t high = (length < U64_MAX_DIGITS && last > u64_pow10(length) - 1) ? u64_pow10(length) - 1 : last;
 
-            // An invalid ID = any ID that has a repeating sequence of exactly 2 occurances
-            for(size_t id = atol(start); id <= (size_t)atol(end); id++)
+        if (!any_repeat)
+        {
+            if (0 == (length & 1))
             {
+                result += repeated_id_sum(low, high, length, length / 2);
+            }
+            continue;
+        }
 
-                uint64_t res = return_value_if_invalid_id(id);
-                if(res != 0) {
-                    clog_debug(__FILE__, "Found value %d invalid;", res);
+        for (unsigned period = 1; period < length; period++)
+        {
+            if (0 == length % period)
+            {
+                /* -mu(length / period) is +1, -1 or 0 for the union */
+                int weight = -mobius(length / period);
+                if (weight > 0)
+                {
+                    result += repeated_id_sum(low, high, length, period);
                 }
-                else {
-                    clog_debug(__FILE__, "Found value %d valid;", id);
+                else if (weight < 0)
+                {
+                    result -= repeated_id_sum(low, high, length, period);
                 }
-                result += res;
             }
-
         }
-
-        id_range = strtok(NULL, ",");
     }
-    clog_debug(__FILE__, "Result %lu", result);
-    
-    free(lines);
     return result;
 }
+#endif // AOC_DAY02_BRUTE_FORCE
 
 /**
- * @brief Solves Day 02 Part 2 of Advent of Code 2025.
- * This function reads the input data and processes it to produce
- * the result for Part 2 of Day 01.
- * @return int32_t The result of Part 2, or -EXIT_FAILURE on error.
+ * @brief Sum the invalid IDs of all ranges in the day02 input
+ * @param any_repeat 0 for part 1, else part 2
+ * @return uint64_t The sum, or -EXIT_FAILURE on error
  */
-uint64_t day02_part2(void)
+static uint64_t day02_solve(int any_repeat)
 {
-    // Implementation for Day 01 Part 1
-    clog_info(__FILE__, "Entering day02_part2 function");
     char** lines = NULL;
     size_t line_count = 0;
 
@@ -173,45 +477,102 @@ uint64_t day02_part2(void)
         return -EXIT_FAILURE;
     }
 
-    char* line = lines[0];
+    const char* line = lines[0];
+    size_t line_length = strlen(line);
+
+    /* Every range but the last ends at a comma */
+    size_t capacity = 1;
+    for (const char* comma = line; (comma = memchr(comma, ',', line_length - (size_t) (comma - line))) != NULL; comma++)
+    {
+        capacity++;
+    }
+    range_t* ranges = malloc(capacity * sizeof(range_t));
+    if (!ranges)
+    {
+        io_free_input(lines);
+        return -EXIT_FAILURE;
+    }
 
-    char *start = NULL, *end = NULL;
+    const char *start = NULL, *end = NULL;
+    size_t start_length = 0, end_length = 0;
+    size_t count = 0;
     uint64_t result = 0;
 
-    char* id_range = strtok(line, ",");
-    while (id_range != NULL)
+    tokenizer_t id_ranges;
+    const char* id_range;
+    size_t id_range_length;
+    tokenizer_init(&id_ranges, line, line_length, ',');
+    while (tokenizer_next(&id_ranges, &id_range, &id_range_length))
     {
-        if (EXIT_SUCCESS == split_string(id_range, '-', &start, &end))
+        tokenizer_t bounds;
+        tokenizer_init(&bounds, id_range, id_range_length, '-');
+        if (tokenizer_next(&bounds, &start, &start_length) && tokenizer_next(&bounds, &end, &end_length))
         {
-            clog_debug(__FILE__, "start: %s; end: %s", start, end);
+            clog_debug(__FILE__, "start: %.*s; end: %.*s", (int) start_length, start, (int) end_length, end);
         }
         else
         {
-            clog_debug(__FILE__, "Error parsing %s", id_range);
+            clog_debug(__FILE__, "Error parsing %.*s", (int) id_range_length, id_range);
+            continue;
         }
 
         // First check to see if the first value is correct
-        if (start[0] >= '1' && start[0] <= '9')
+        if (start_length > 0 && start[0] >= '1' && start[0] <= '9')
         {
-
-            // An invalid ID = any ID that has a repeating sequence of exactly 2 occurances
-            for (size_t id = atol(start); id <= (size_t) atol(end); id++)
-            {
-
-                uint64_t res = return_value_if_invalid_id_part2(id);
-                if (res != 0)
-                {
-                    clog_debug(__FILE__, "Found value %d invalid;", res);
-                }
-
-                result += res;
-            }
+            parse_u64(start, start_length, &ranges[count].start);
+            parse_u64(end, end_length, &ranges[count].end_including);
+            count++;
         }
+    }
+
+    /* Overlapping ranges would count their common IDs twice: scan their union */
+    interval_set_t ids;
+    uint32_t status = interval_set_build(&ids, ranges, count);
+    free(ranges);
+    io_free_input(lines);
+    if (EXIT_FAILURE == status)
+    {
+        return -EXIT_FAILURE;
+    }
 
-        id_range = strtok(NULL, ",");
+#ifdef AOC_DAY02_BRUTE_FORCE
+    result = day02_brute_force_sum(ids.ranges, ids.count, any_repeat);
+#else
+    /* Closed form: a handful of arithmetic series per range, not worth a thread */
+    for (size_t range = 0; range < ids.count; range++)
+    {
+        result += invalid_id_sum(ids.ranges[range].start, ids.ranges[range].end_including, any_repeat);
     }
+#endif
     clog_debug(__FILE__, "Result %lu", result);
 
-    free(lines);
+    interval_set_free(&ids);
     return result;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Solves Day 02 Part 1 of Advent of Code 2025.
+ * This function reads the input data and processes it to produce
+ * the result for Part 1 of Day 02.
+ * @return uint64_t The result of Part 1, or -EXIT_FAILURE on error.
+ */
+uint64_t
+day02_part1(void)
+{
+    clog_info(__FILE__, "Entering day02_part1 function");
+    // An invalid ID = any ID that has a repeating sequence of exactly 2 occurances
+    return day02_solve(0);
+}
+
+/**
+ * @brief Solves Day 02 Part 2 of Advent of Code 2025.
+ * This function reads the input data and processes it to produce
+ * the result for Part 2 of Day 01.
+ * @return int32_t The result of Part 2, or -EXIT_FAILURE on error.
+ */
+uint64_t day02_part2(void)
+{
+    clog_info(__FILE__, "Entering day02_part2 function");
+    // An invalid ID = any ID made of a sequence repeated at least twice
+    return day02_solve(1);
+}
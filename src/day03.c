@@ -24,158 +24,417 @@
 #include "aoc.h"
 #include "conversion.h"
 #include "io.h"
-#include "sort.h"
+#include "parallel.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/* Batteries turned on per bank in part 1, and by default in part 2 */
+#define DAY03_PART1_KEEP 2
+#define DAY03_PART2_KEEP 12
+/* Ranges of banks per thread, so uneven ranges balance out */
+#define DAY03_TASKS_PER_THREAD 4
+/* Up to this many digits the greedy search is used (and the joltage fits a uint64_t) */
+#define DAY03_GREEDY_MAX_KEEP 19
+/* Decimal digits per limb of a wide_t */
+#define DAY03_LIMB_DIGITS 18
+#define DAY03_LIMB_BASE 1000000000000000000ULL
+/* Per-task buffers are padded to this, so tasks never write to a shared cache line */
+#define DAY03_CACHE_LINE 64
+
+/* Batteries turned on per bank in part 2, see day03_set_keep() */
+static size_t day03_keep = DAY03_PART2_KEEP;
 
 /**
- * @brief Solves Day 03 Part 1 of Advent of Code 2025.
- * This function reads the input data and processes it to produce
- * the result for Part 1 of Day 03.
- * @return uint32_t The result of Part 1, or EXIT_FAILURE on error.
+ * @brief Find the first occurrence of the largest digit.
+ * Stops at the first '9', which nothing can beat. Otherwise a SIMD
+ * maximum over the digits is followed by a search for its first
+ * occurrence.
+ * @param digits The digits (not NUL-terminated)
+ * @param length Number of digits, at least 1
+ * @return size_t Index of the first largest digit
  */
-uint32_t day03_part1(void)
+static size_t bank_first_max(const char* digits, size_t length)
 {
-    // Implementation for Day 01 Part 1
-    clog_info(__FILE__, "Entering day03_part1 function");
-    char** lines = NULL;
-    size_t line_count = 0;
-    uint32_t joltage = 0;
-
-    if (EXIT_FAILURE == io_read_input("day03.txt", &lines, &line_count))
+    unsigned char best = 0;
+    size_t index = 0;
+#ifdef __SSE2__
+    const __m128i nine = _mm_set1_epi8('9');
+    __m128i maximum = _mm_setzero_si128();
+    for (; index + 16 <= length; index += 16)
     {
-        return -EXIT_FAILURE;
+        __m128i chunk = _mm_loadu_si128((const __m128i*) (digits + index));
+        unsigned nines = (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, nine));
+        if (nines)
+        {
+            return index + (size_t) __builtin_ctz(nines);
+        }
+        maximum = _mm_max_epu8(maximum, chunk);
+    }
+    /* Horizontal maximum: fold the 16 bytes in halves */
+    maximum = _mm_max_epu8(maximum, _mm_srli_si128(maximum, 8));
+    maximum = _mm_max_epu8(maximum, _mm_srli_si128(maximum, 4));
+    maximum = _mm_max_epu8(maximum, _mm_srli_si128(maximum, 2));
+    maximum = _mm_max_epu8(maximum, _mm_srli_si128(maximum, 1));
+    best = (unsigned char) _mm_cvtsi128_si32(maximum);
+#endif
+    for (size_t tail = index; tail < length; tail++)
+    {
+        if ((unsigned char) digits[tail] > best)
+        {
+            best = (unsigned char) digits[tail];
+            if ('9' == best)
+            {
+                /* Nothing before the tail reached '9', so this is the first one */
+                return tail;
+            }
+        }
     }
 
-    for(size_t i=0; i<line_count; i++) {
-        // Process each line as needed
-        char* bank = aoc_strdup(lines[i]);
+    index = 0;
+#ifdef __SSE2__
+    const __m128i target = _mm_set1_epi8((char) best);
+    for (; index + 16 <= length; index += 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*) (digits + index));
+        unsigned hits = (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, target));
+        if (hits)
+        {
+            return index + (size_t) __builtin_ctz(hits);
+        }
+    }
+#endif
+    while ((unsigned char) digits[index] != best)
+    {
+        index++;
+    }
+    return index;
+}
 
-        uint8_t max_battery_1 = 0, index_max_battery_1 = 0;
+/**
+ * @brief Get the largest joltage a bank gives with `keep` batteries on.
+ * Picks the digits greedily: the next digit is the first largest one
+ * that still leaves enough digits after it for the rest.
+ * @param digits The bank (not NUL-terminated)
+ * @param length Number of digits, at least keep
+ * @param keep   Number of batteries to turn on, at most 19
+ * @return uint64_t The joltage
+ */
+static uint64_t bank_joltage(const char* digits, size_t length, size_t keep)
+{
+    uint64_t joltage = 0;
+    size_t start = 0;
+    for (size_t picked = 0; picked < keep; picked++)
+    {
+        size_t window = length - start - (keep - picked - 1);
+        size_t index = start + bank_first_max(digits + start, window);
+        joltage = joltage * 10 + (uint64_t) (digits[index] - '0');
+        start = index + 1;
+    }
+    return joltage;
+}
 
-        for (size_t index = 0; index < strlen(bank) - 1; index++)
+/**
+ * @brief Pick the largest `keep`-digit subsequence of a bank in O(length).
+ * A monotonic stack bounded to `keep` digits: a digit pops the smaller
+ * digits before it while deletions are left, and a digit that finds the
+ * stack full is deleted itself. Works for any keep, without the
+ * O(length * keep) cost of the greedy search.
+ * @param digits The bank (not NUL-terminated)
+ * @param length Number of digits, at least keep
+ * @param keep   Number of batteries to turn on
+ * @param stack  Buffer of at least keep characters, filled with the picked digits
+ */
+static void bank_select(const char* digits, size_t length, size_t keep, char* stack)
+{
+    size_t deletions = length - keep;
+    size_t top = 0;
+    for (size_t index = 0; index < length; index++)
+    {
+        char digit = digits[index];
+        while (deletions > 0 && top > 0 && stack[top - 1] < digit)
         {
-            if ((bank[index] - '0') > max_battery_1)
-            {
-                max_battery_1 = bank[index] - '0';
-                index_max_battery_1 = index;
-            }
+            top--;
+            deletions--;
         }
-        uint8_t max_battery_2 = 0;
-        for (size_t index = index_max_battery_1+1; index < strlen(bank); index++)
+        if (top < keep)
         {
-            if ((bank[index] - '0') > max_battery_2)
-            {
-                max_battery_2 = bank[index] - '0';
-            }
+            stack[top++] = digit;
         }
-        joltage += (max_battery_1 * 10) + max_battery_2;
-        free(bank);
+        else
+        {
+            deletions--;
         }
+    }
+}
 
-    // Clean up and return failure as not implemented yet
-    for(size_t i=0; i<line_count; i++) {
-        free(lines[i]);
+/**
+ * @brief A non-negative integer of any size, in base 10^18 limbs.
+ * Joltages with more than 19 digits do not fit a uint64_t, and their
+ * sums not even a __uint128_t, so they are added up limb by limb.
+ */
+typedef struct {
+    uint64_t* limbs; /* least significant limb first */
+    size_t count;    /* number of limbs */
+} wide_t;
+
+/**
+ * @brief Add a value below DAY03_LIMB_BASE at a given limb.
+ * A carry beyond the last limb is dropped; wide numbers are sized so
+ * that it cannot happen.
+ */
+static void wide_add_limb(wide_t* number, size_t limb, uint64_t value)
+{
+    for (; value > 0 && limb < number->count; limb++)
+    {
+        number->limbs[limb] += value;
+        value = number->limbs[limb] >= DAY03_LIMB_BASE;
+        if (value)
+        {
+            number->limbs[limb] -= DAY03_LIMB_BASE;
+        }
     }
-    free(lines);
-    return joltage;
 }
+
 /**
- * @brief  Find the largest possible number after removing exactly *k* digits.
- *
- * @details
- * Given a decimal string (e.g. <code>"234234234278"</code>) you may delete
- * exactly <em>k</em> characters while preserving the original order of the
- * remaining characters.  The goal is to obtain the numerically greatest value
- * that can be formed after the deletions.
- *
- * Example (k = 3):
- *
- * @code
- * original : 2 3 4 2 3 4 2 3 4 2 7 8
- * delete   : ^ ^   ^               (the first 2, the first 3, the second 2)
- * result   : 4 3 4 2 3 4 2 3 4 2 7 8  → 434234234278
- * @endcode
- *
- * This problem is the classic “maximum number after k deletions”
- * (also known as “largest number after removing k digits”).
- *
- * @param src  Null‑terminated source string from which the maximum number
- *             will be derived.
- * @param k    Number of characters to remove (0 ≤ k ≤ strlen(src)).
- *
- * @return A newly allocated null‑terminated string containing the maximal
- *         number.  The caller is responsible for freeing the returned buffer
- *         with <code>free()</code>.  If memory allocation fails, the function
- *         returns <code>NULL</code>.
+ * @brief Add a decimal number given as its digits.
  */
-char* max_after_k_deletions(const char* src, int k)
+static void wide_add_digits(wide_t* number, const char* digits, size_t length)
 {
-    size_t src_length = strlen(src);
-    if (k >= (int)src_length)
-    { 
-        // deleting everything → empty string
-        char* empty = malloc(1);
-        empty[0] = '\0';
-        return empty;
+    for (size_t limb = 0; limb * DAY03_LIMB_DIGITS < length; limb++)
+    {
+        size_t end = length - limb * DAY03_LIMB_DIGITS;
+        size_t start = end > DAY03_LIMB_DIGITS ? end - DAY03_LIMB_DIGITS : 0;
+        uint64_t value = 0;
+        for (size_t index = start; index < end; index++)
+        {
+            value = value * 10 + (uint64_t) (digits[index] - '0');
+        }
+        wide_add_limb(number, limb, value);
     }
+}
 
-    /* Dynamic array acting as a stack */
-    char* stack = malloc(src_length + 1); // +1 for terminating NUL
-    size_t top = 0;              // number of elements in stack
+/**
+ * @brief Reduce a wide number modulo 2^128.
+ */
+static __uint128_t wide_to_u128(const wide_t* number)
+{
+    __uint128_t value = 0;
+    for (size_t limb = number->count; limb-- > 0;)
+    {
+        value = value * DAY03_LIMB_BASE + number->limbs[limb];
+    }
+    return value;
+}
+
+/**
+ * @brief Format a wide number in decimal.
+ * @return char* The digits, NUL-terminated, to be released with free(); NULL when out of memory
+ */
+static char* wide_to_str(const wide_t* number)
+{
+    size_t top = number->count;
+    while (top > 1 && 0 == number->limbs[top - 1])
+    {
+        top--;
+    }
+
+    char* text = malloc(top * DAY03_LIMB_DIGITS + 1);
+    if (!text)
+    {
+        return NULL;
+    }
+    size_t length = u64_to_str(number->limbs[top - 1], text);
+    for (size_t limb = top - 1; limb-- > 0;)
+    {
+        /* Lower limbs are padded to their full DAY03_LIMB_DIGITS digits */
+        char digits[U64_MAX_DIGITS + 1];
+        size_t count = u64_to_str(number->limbs[limb], digits);
+        memset(text + length, '0', DAY03_LIMB_DIGITS - count);
+        memcpy(text + length + DAY03_LIMB_DIGITS - count, digits, count);
+        length += DAY03_LIMB_DIGITS;
+    }
+    text[length] = '\0';
+    return text;
+}
+
+/**
+ * @brief The banks of the input, split into one range of banks per task.
+ * All buffers are allocated up front, so the tasks never allocate.
+ */
+typedef struct {
+    const io_line_t* banks;
+    size_t count;
+    size_t tasks;
+    size_t keep;
+    size_t stride; /* bytes between the stacks of two tasks */
+    char* stacks;  /* keep characters per task for bank_select() */
+    wide_t* sums;  /* private sum per task */
+} bank_work_t;
 
-    for (size_t char_index = 0; char_index < src_length; ++char_index)
+/**
+ * @brief Sum the joltages of one range of banks.
+ * Up to DAY03_GREEDY_MAX_KEEP digits the greedy SIMD search is used and
+ * the joltage is a uint64_t; beyond that the bounded monotonic stack.
+ * @param task    Index of the task
+ * @param context The bank_work_t
+ */
+static void bank_task(size_t task, void* context)
+{
+    const bank_work_t* work = (const bank_work_t*) context;
+    size_t first = work->count * task / work->tasks;
+    size_t last = work->count * (task + 1) / work->tasks;
+    wide_t* sum = &work->sums[task];
+    char* stack = work->stacks + task * work->stride;
+    /* Fewer than 10^19 banks of fewer than 10^19 each stay below 2^128 */
+    __uint128_t greedy = 0;
+
+    for (size_t bank = first; bank < last; bank++)
     {
-        char current_char = src[char_index];
-        while (k > 0 && top > 0 && stack[top - 1] < current_char)
+        const char* digits = work->banks[bank].data;
+        size_t length = work->banks[bank].length;
+        while (length > 0 && (digits[length - 1] < '0' || digits[length - 1] > '9'))
+        {
+            length--; /* a '\r' of a CRLF file */
+        }
+        if (length < work->keep)
+        {
+            continue;
+        }
+
+        if (work->keep <= DAY03_GREEDY_MAX_KEEP)
         {
-            --top; // pop
-            --k;
+            greedy += bank_joltage(digits, length, work->keep);
         }
-        stack[top++] = current_char; // push
+        else
+        {
+            bank_select(digits, length, work->keep, stack);
+            wide_add_digits(sum, stack, work->keep);
+        }
+    }
+    for (size_t limb = 0; greedy > 0; limb++, greedy /= DAY03_LIMB_BASE)
+    {
+        wide_add_limb(sum, limb, (uint64_t) (greedy % DAY03_LIMB_BASE));
+    }
+}
+
+/**
+ * @brief Sum the joltages of all banks, spread over all threads.
+ * @param keep  Number of batteries to turn on per bank
+ * @param total Filled with the sum; release total->limbs with free()
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
+ */
+static uint32_t bank_total(size_t keep, wide_t* total)
+{
+    io_mapped_input_t input;
+    if (EXIT_FAILURE == io_map_input("day03.txt", &input))
+    {
+        return (uint32_t) EXIT_FAILURE;
     }
 
-    /* If deletions remain, drop from the end */
-    while (k > 0 && top > 0)
+    unsigned threads = parallel_thread_count();
+    size_t tasks = (size_t) threads * DAY03_TASKS_PER_THREAD;
+    if (tasks > input.line_count)
     {
-        --top;
-        --k;
+        tasks = input.line_count > 0 ? input.line_count : 1;
     }
 
-    stack[top] = '\0'; // NUL‑terminate
-    return stack;      // caller owns the buffer
+    /* Room for keep digits plus the carries of up to 10^19 banks, in whole cache lines */
+    const size_t line_limbs = DAY03_CACHE_LINE / sizeof(uint64_t);
+    size_t limbs = ((keep + U64_MAX_DIGITS) / DAY03_LIMB_DIGITS + 1 + line_limbs - 1) / line_limbs * line_limbs;
+    size_t stride = (keep + DAY03_CACHE_LINE - 1) / DAY03_CACHE_LINE * DAY03_CACHE_LINE;
+    bank_work_t work = {input.lines, input.line_count, tasks, keep, stride,
+                        aligned_alloc(DAY03_CACHE_LINE, tasks * stride), malloc(tasks * sizeof(wide_t))};
+    uint64_t* sum_limbs = aligned_alloc(DAY03_CACHE_LINE, (tasks + 1) * limbs * sizeof(uint64_t));
+    if (!work.stacks || !work.sums || !sum_limbs)
+    {
+        free(work.stacks);
+        free(work.sums);
+        free(sum_limbs);
+        io_unmap_input(&input);
+        return (uint32_t) EXIT_FAILURE;
+    }
+    memset(sum_limbs, 0, (tasks + 1) * limbs * sizeof(uint64_t));
+    for (size_t task = 0; task < tasks; task++)
+    {
+        work.sums[task].limbs = sum_limbs + (task + 1) * limbs;
+        work.sums[task].count = limbs;
+    }
+    parallel_for(tasks, threads, bank_task, &work);
+
+    /* The first block of limbs is the total; the caller releases it */
+    total->limbs = sum_limbs;
+    total->count = limbs;
+    for (size_t task = 0; task < tasks; task++)
+    {
+        for (size_t limb = 0; limb < limbs; limb++)
+        {
+            wide_add_limb(total, limb, work.sums[task].limbs[limb]);
+        }
+    }
+
+    free(work.stacks);
+    free(work.sums);
+    io_unmap_input(&input);
+    return (uint32_t) EXIT_SUCCESS;
+}
+
+void day03_set_keep(size_t keep)
+{
+    day03_keep = keep > 0 ? keep : DAY03_PART2_KEEP;
 }
 
 /**
  * @brief Solves Day 03 Part 1 of Advent of Code 2025.
  * This function reads the input data and processes it to produce
  * the result for Part 1 of Day 03.
- * @return __uint128_t The result of Part 2, or EXIT_FAILURE on error.
+ * @return uint32_t The result of Part 1, or EXIT_FAILURE on error.
  */
-__uint128_t day03_part2(void)
-{ // Implementation for Day 01 Part 1
-    // Implementation for Day 01 Part 1
-    clog_info(__FILE__, "Entering day03_part2 function");
-    char** lines = NULL;
-    size_t line_count = 0;
+uint32_t day03_part1(void)
+{
+    clog_info(__FILE__, "Entering day03_part1 function");
+    wide_t joltage;
 
-    if (EXIT_FAILURE == io_read_input("day03.txt", &lines, &line_count))
+    if (EXIT_FAILURE == bank_total(DAY03_PART1_KEEP, &joltage))
     {
         return -EXIT_FAILURE;
     }
+    uint32_t result = (uint32_t) wide_to_u128(&joltage);
+    free(joltage.limbs);
+    return result;
+}
 
-    __uint128_t total_joltages =0;
-    for (size_t line_index = 0; line_index < line_count; line_index++)
+/**
+ * @brief Solves Day 03 Part 2 of Advent of Code 2025.
+ * This function reads the input data and processes it to produce
+ * the result for Part 2 of Day 03.
+ * @return __uint128_t The result of Part 2 (modulo 2^128), or EXIT_FAILURE on error.
+ */
+__uint128_t day03_part2(void)
+{
+    clog_info(__FILE__, "Entering day03_part2 function");
+    wide_t total_joltages;
+
+    if (EXIT_FAILURE == bank_total(day03_keep, &total_joltages))
     {
-        // Process each line as needed
-        char* bank = max_after_k_deletions(lines[line_index], strlen(lines[line_index]) - 12);
-        total_joltages+=atoll(bank);
-        free(bank);
+        return -EXIT_FAILURE;
     }
+    __uint128_t result = wide_to_u128(&total_joltages);
+    free(total_joltages.limbs);
+    return result;
+}
+
+char* day03_part2_str(void)
+{
+    clog_info(__FILE__, "Entering day03_part2_str function");
+    wide_t total_joltages;
 
-    // Clean up and return failure as not implemented yet
-    for (size_t i = 0; i < line_count; i++)
+    if (EXIT_FAILURE == bank_total(day03_keep, &total_joltages))
     {
-        free(lines[i]);
+        return NULL;
     }
-    free(lines);
-    return total_joltages;
+    char* result = wide_to_str(&total_joltages);
+    free(total_joltages.limbs);
+    return result;
 }
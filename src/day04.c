@@ -18,6 +18,7 @@
  *     - CLogger: For logging functionality.
  *     - Standard C Library: For input/output and standard utilities.
  *=====================================================================*/
+#include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -29,31 +30,23 @@
 
 /**
  * @brief find the number of rolls adjecent to the current cell
+ * The grid is surrounded by a ring of sentinel cells, so every neighbour
+ * can be read without a boundary test.
  */
 int8_t find_adjacent_roll_count(grid_t *grid, uint32_t row, uint32_t column)
 {
     if (column > grid->columns || row > grid->rows)
         return EXIT_FAILURE;
 
-    /* Relative row/column deltas for the 8 neighbours */
-    static const int direction_row[8] = {-1, -1, -1, 0, 0, 1, 1, 1};
-    static const int direction_column[8] = {-1, 0, 1, -1, 1, -1, 0, 1};
+    /* Offsets of the 8 neighbours in the padded, row‑major buffer */
+    const ptrdiff_t stride = (ptrdiff_t) grid->stride;
+    const ptrdiff_t offsets[8] = {-stride - 1, -stride, -stride + 1, -1, 1, stride - 1, stride, stride + 1};
+    const char* cell = grid->cells + (size_t) row * grid->stride + column;
     unsigned hits = 0U;
 
     for (int i = 0; i < 8; ++i)
     {
-        int nr = (int) row + direction_row[i]; /* neighbour row (may be negative) */
-        int nc = (int) column + direction_column[i]; /* neighbour column */
-
-        /* Boundary test – skip neighbours that fall outside the grid */
-        if (nr < 0 || nr >= (int) grid->rows || nc < 0 || nc >= (int) grid->columns)
-            continue;
-
-        /* Index into the flat buffer (row‑major order) */
-        size_t idx = (size_t) nr * grid->columns + (size_t) nc;
-
-        if (grid->cells[idx] == '@')
-            hits++;
+        hits += ('@' == cell[offsets[i]]);
     }
 
     return hits;
@@ -70,6 +63,7 @@ uint32_t day04_part1(void)
 
     if (EXIT_FAILURE == io_read_grid("day04.txt", grid))
     {
+        free(grid);
         return -EXIT_FAILURE;
     }
     
@@ -77,7 +71,7 @@ uint32_t day04_part1(void)
     for (size_t row = 0; row < grid->rows; row++)
     {
         for(size_t col = 0; col < grid->columns; col++) {
-            if('@' == grid->cells[(row*grid->columns) + col]) {
+            if('@' == grid->cells[(row*grid->stride) + col]) {
                 int8_t hits = find_adjacent_roll_count(grid, row, col);
                 total_roll_count += (hits >= 0 && hits < 4);
             }
@@ -85,7 +79,7 @@ uint32_t day04_part1(void)
 
     }
 
-    free(grid->cells);
+    io_free_grid(grid);
     free(grid);
     return total_roll_count;
 }
@@ -101,18 +95,20 @@ uint32_t day04_part2(void)
 
     if (EXIT_FAILURE == io_read_grid("day04.txt", grid))
     {
+        free(grid);
         return -EXIT_FAILURE;
     }
 
-    size_t buf_size = grid->columns * grid->rows;
-    char* stack = malloc(buf_size);
-    if (NULL == stack) {
-        free(grid->cells);
+    size_t buf_size = grid->buffer_size;
+    char* stack_buffer = malloc(buf_size);
+    if (NULL == stack_buffer) {
+        io_free_grid(grid);
         free(grid);
         return -EXIT_FAILURE;
     }
     /* initialize stack with current grid contents to avoid uninitialized writes */
-    memcpy(stack, grid->cells, buf_size);
+    memcpy(stack_buffer, grid->buffer, buf_size);
+    char* stack = stack_buffer + (grid->cells - grid->buffer);
     uint32_t total_roll_count = 0;
     uint32_t rolls_this_round = 0;
 
@@ -123,7 +119,7 @@ uint32_t day04_part2(void)
         {
             for (size_t col = 0; col < grid->columns; col++)
             {
-                size_t idx = (row * grid->columns) + col;
+                size_t idx = (row * grid->stride) + col;
                 if ('@' == grid->cells[idx])
                 {
                     int8_t hits = find_adjacent_roll_count(grid, row, col);
@@ -140,10 +136,10 @@ uint32_t day04_part2(void)
                 }
             }
         }
-        memcpy(grid->cells, stack, buf_size);
+        memcpy(grid->buffer, stack_buffer, buf_size);
     } while (rolls_this_round > 0);
-    free(stack);
-    free(grid->cells);
+    free(stack_buffer);
+    io_free_grid(grid);
     free(grid);
     return total_roll_count;
 }
@@ -22,14 +22,155 @@
 #include <string.h>
 
 #include "aoc.h"
+#include "cache.h"
 #include "conversion.h"
+#include "interval.h"
 #include "io.h"
-#include "sort.h"
+#include "parse.h"
 
-typedef struct range {
-    uint64_t start;
-    uint64_t end_including;
-} range_t;
+/**
+ * @brief Parse a range like "10-14".
+ * @param src    Characters to parse (does not need to be NUL-terminated)
+ * @param length Number of characters available in src
+ * @param range  The range to fill
+ */
+static void parse_range(const char* src, size_t length, range_t* range)
+{
+    size_t consumed = parse_u64(src, length, &range->start);
+    range->end_including = range->start;
+    if (consumed < length && '-' == src[consumed])
+    {
+        parse_u64(src + consumed + 1, length - consumed - 1, &range->end_including);
+    }
+}
+
+/* Layout tag of the cached inventory: day 05, version 1 */
+#define DAY05_CACHE_FORMAT 0x0501
+
+/**
+ * @brief The parsed puzzle input: the fresh ranges and the available ids.
+ * Cached as [uint64_t range_count][uint64_t id_count][ranges...][ids...].
+ */
+typedef struct {
+    const range_t* ranges;   /* the fresh ingredient id ranges */
+    size_t range_count;      /* number of ranges */
+    const uint64_t* ids;     /* the available ingredient ids */
+    size_t id_count;         /* number of ids */
+    range_t* owned_ranges;   /* ranges parsed from text (NULL when mapped from the cache) */
+    uint64_t* owned_ids;     /* ids parsed from text (NULL when mapped from the cache) */
+    cache_t cache;           /* cache mapping the inventory (when loaded from the cache) */
+} inventory_t;
+
+/**
+ * @brief Make room for one more element in a growing array.
+ * @param array    The array to grow (updated)
+ * @param count    Number of elements in use
+ * @param capacity Number of elements allocated (updated)
+ * @param size     Size of one element
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
+ */
+static uint32_t reserve_one(void** array, size_t count, size_t* capacity, size_t size)
+{
+    if (count < *capacity)
+    {
+        return (uint32_t) EXIT_SUCCESS;
+    }
+    size_t new_capacity = *capacity ? *capacity * 2 : 1024;
+    void* tmp = realloc(*array, new_capacity * size);
+    if (!tmp)
+    {
+        return (uint32_t) EXIT_FAILURE;
+    }
+    *array = tmp;
+    *capacity = new_capacity;
+    return (uint32_t) EXIT_SUCCESS;
+}
+
+/**
+ * @brief Release an inventory loaded by inventory_load().
+ * @param inventory The inventory to release
+ */
+static void inventory_free(inventory_t* inventory)
+{
+    free(inventory->owned_ranges);
+    free(inventory->owned_ids);
+    cache_release(&inventory->cache);
+    memset(inventory, 0, sizeof(*inventory));
+}
+
+/**
+ * @brief Load the fresh ranges and available ids.
+ * The inventory is mapped from the .aocbin cache when it is still valid.
+ * Otherwise the input is streamed, parsed and the inventory is cached.
+ * @param inventory The inventory to fill
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
+ */
+static uint32_t inventory_load(inventory_t* inventory)
+{
+    memset(inventory, 0, sizeof(*inventory));
+    if (EXIT_SUCCESS == cache_load("day05.txt", DAY05_CACHE_FORMAT, &inventory->cache))
+    {
+        const uint64_t* counts = (const uint64_t*) inventory->cache.payload;
+        size_t header_size = 2 * sizeof(uint64_t);
+        if (inventory->cache.payload_size >= header_size &&
+            inventory->cache.payload_size == header_size + counts[0] * sizeof(range_t) + counts[1] * sizeof(uint64_t))
+        {
+            inventory->range_count = counts[0];
+            inventory->id_count = counts[1];
+            inventory->ranges = (const range_t*) (counts + 2);
+            inventory->ids = (const uint64_t*) (inventory->ranges + inventory->range_count);
+            return (uint32_t) EXIT_SUCCESS;
+        }
+        cache_release(&inventory->cache);
+    }
+
+    io_line_reader_t reader;
+    io_line_t line;
+    if (EXIT_FAILURE == io_reader_open("day05.txt", &reader))
+    {
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    size_t range_capacity = 0, id_capacity = 0;
+    int failed = 0;
+    while (!failed && io_reader_next(&reader, &line) && line.length > 0)
+    {
+        failed = EXIT_FAILURE == reserve_one((void**) &inventory->owned_ranges, inventory->range_count,
+                                             &range_capacity, sizeof(range_t));
+        if (!failed)
+        {
+            parse_range(line.data, line.length, &inventory->owned_ranges[inventory->range_count++]);
+        }
+    }
+    // The empty separator line has been consumed above; the ids follow
+    while (!failed && io_reader_next(&reader, &line))
+    {
+        failed = EXIT_FAILURE == reserve_one((void**) &inventory->owned_ids, inventory->id_count, &id_capacity,
+                                             sizeof(uint64_t));
+        if (!failed)
+        {
+            parse_u64(line.data, line.length, &inventory->owned_ids[inventory->id_count++]);
+        }
+    }
+
+    failed |= reader.error;
+    io_reader_close(&reader);
+    if (failed)
+    {
+        inventory_free(inventory);
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    inventory->ranges = inventory->owned_ranges;
+    inventory->ids = inventory->owned_ids;
+
+    uint64_t counts[2] = {inventory->range_count, inventory->id_count};
+    cache_section_t sections[3] = {{counts, sizeof(counts)},
+                                   {inventory->ranges, inventory->range_count * sizeof(range_t)},
+                                   {inventory->ids, inventory->id_count * sizeof(uint64_t)}};
+    cache_store("day05.txt", DAY05_CACHE_FORMAT, sections, 3);
+    return (uint32_t) EXIT_SUCCESS;
+}
 
 /**
  * @brief Solves Day 05 Part 1 of Advent of Code 2025.
@@ -40,67 +181,32 @@ typedef struct range {
 uint32_t day05_part1(void)
 {
     clog_info(__FILE__, "Entering day05_part1 function");
-    char** lines = NULL;
-    size_t line_count = 0;
+    inventory_t inventory;
 
-    if (EXIT_FAILURE == io_read_input("day05.txt", &lines, &line_count))
+    if (EXIT_FAILURE == inventory_load(&inventory))
     {
         return -EXIT_FAILURE;
     }
 
-    size_t line_index = 0;
-
-
-    struct range* fresh_ingredients_ids = malloc(sizeof(struct range));
-    size_t range_capacity=1;
-    while (strlen(lines[line_index]) > 0) {
-        if (range_capacity <= line_index)
-        {
-            range_capacity = (line_index * 2);
-            fresh_ingredients_ids = realloc(fresh_ingredients_ids, range_capacity * sizeof(struct range));
-        }
-        uint64_t start, end;
-        sscanf(lines[line_index], "%lu-%lu", &start, &end);
-        fresh_ingredients_ids[line_index].start = start;
-        fresh_ingredients_ids[line_index].end_including = end;
-        line_index++;
+    interval_set_t fresh;
+    if (EXIT_FAILURE == interval_set_build(&fresh, inventory.ranges, inventory.range_count))
+    {
+        inventory_free(&inventory);
+        return -EXIT_FAILURE;
     }
 
-    size_t range_size = line_index;
-    line_index++; //skip empty line
     uint64_t available_ingredient_ids = 0;
-    while (line_index < line_count)
+    for (size_t id_index = 0; id_index < inventory.id_count; id_index++)
     {
-        uint64_t ingredient_id;
-
-        ingredient_id = (uint64_t) atoll(lines[line_index]);
-        size_t index=0;
-        while (index < range_size) {
-            if (ingredient_id >= fresh_ingredients_ids[index].start &&
-                ingredient_id <= fresh_ingredients_ids[index].end_including) {
-                    available_ingredient_ids++;
-                    break;
-                };
-            index++;
-        }
-        line_index++;
+        available_ingredient_ids += (uint64_t) interval_set_contains(&fresh, inventory.ids[id_index]);
     }
 
-    free(lines);
-    free(fresh_ingredients_ids);
+    interval_set_free(&fresh);
+    inventory_free(&inventory);
 
     return available_ingredient_ids;
 }
 
-int range_compare(const void *left, const void *right) {
-    const range_t *left_range = (const range_t *)left;
-    const range_t *right_range = (const range_t *)right;
-    
-    if (left_range->start < right_range->start) return -1;
-    if (left_range->start > right_range->start) return 1;
-    return 0;
-}
-
 /**
  * @brief Solves Day 05 Part 2 of Advent of Code 2025.
  * This function reads the input data and processes it to produce
@@ -111,59 +217,24 @@ uint64_t day05_part2(void)
 {
 
     clog_info(__FILE__, "Entering day05_part2 function");
-    char** lines = NULL;
-    size_t line_count = 0;
+    inventory_t inventory;
 
-    if (EXIT_FAILURE == io_read_input("day05.txt", &lines, &line_count))
+    if (EXIT_FAILURE == inventory_load(&inventory))
     {
         return -EXIT_FAILURE;
     }
 
-    size_t range_size = 0;
-    range_t ranges[line_count];
-
-    while (range_size < line_count && '\n' != lines[range_size][0] && '\0' != lines[range_size][0])
+    interval_set_t fresh;
+    if (EXIT_FAILURE == interval_set_build(&fresh, inventory.ranges, inventory.range_count))
     {
-        uint64_t start, end;
-        sscanf(lines[range_size], "%lu-%lu", &start, &end);
-        ranges[range_size].start = start;
-        ranges[range_size].end_including = end;
-        range_size++;
+        inventory_free(&inventory);
+        return -EXIT_FAILURE;
     }
 
-    qsort(ranges, range_size, sizeof(range_t), range_compare);
-
-    size_t combined_range_size=0;
-    range_t combined_ranges[range_size+1];
-    memset(combined_ranges, 0, sizeof combined_ranges);
-
-    combined_ranges[0].start = ranges[0].start;
-    combined_ranges[0].end_including = ranges[0].end_including;
-
-    for (size_t index = 0; index < range_size; index++)
-    {
-        // Check to see if the start > combined start and start < end_including
-        if ((ranges[index].start <= combined_ranges[combined_range_size].end_including) &&
-            (ranges[index].end_including > combined_ranges[combined_range_size].end_including))
-        {
-            combined_ranges[combined_range_size].end_including = ranges[index].end_including;
-        }
-
-        if (ranges[index].start > combined_ranges[combined_range_size].end_including)
-        {
-            combined_range_size++;
-            combined_ranges[combined_range_size].start = ranges[index].start;
-            combined_ranges[combined_range_size].end_including = ranges[index].end_including;
-        }
-    };
-
-    __uint128_t sum=0;
-    for (size_t index = 0; index <= combined_range_size; index++) {
-        if (combined_ranges[index].end_including > 0 && combined_ranges[index].start > 0)
-            sum += (combined_ranges[index].end_including - combined_ranges[index].start) + 1;
-    }
+    __uint128_t sum = interval_set_length(&fresh);
 
-    free(lines);
+    interval_set_free(&fresh);
+    inventory_free(&inventory);
 
     return sum;
 }
\ No newline at end of file
@@ -22,7 +22,9 @@
 #include <string.h>
 
 #include "aoc.h"
+#include "conversion.h"
 #include "io.h"
+#include "parse.h"
 
 #ifndef TESTING
     #define ROWS_WITH_NUMBERS 4
@@ -55,20 +57,25 @@ uint64_t day06_part1(void)
     for (size_t row_index = 0; row_index < ROWS_WITH_NUMBERS; row_index++)
     {
         size_t column_index = 0;
-        char* number = strtok(lines[row_index], " ");
-        while (number != NULL)
+        tokenizer_t numbers_in_row;
+        const char* number;
+        size_t number_length;
+        tokenizer_init(&numbers_in_row, lines[row_index], strlen(lines[row_index]), TOKENIZER_WHITESPACE);
+        while (column_index <= COLUMNS_WITH_NUMBERS && tokenizer_next(&numbers_in_row, &number, &number_length))
         {
-            numbers[row_index][column_index++] = atol(number);
-            number = strtok(NULL, " ");
+            parse_u32(number, number_length, &numbers[row_index][column_index++]);
         }
     }
 
     // EXECUTE THE SUM
     size_t column_index = 0;
-    char* action = strtok(lines[line_count-1], " ");
+    tokenizer_t actions;
+    const char* action;
+    size_t action_length;
+    tokenizer_init(&actions, lines[line_count-1], strlen(lines[line_count-1]), TOKENIZER_WHITESPACE);
     uint64_t column_result=0;
     uint64_t total_sum = 0;
-    while (action != NULL)
+    while (column_index <= COLUMNS_WITH_NUMBERS && tokenizer_next(&actions, &action, &action_length))
     {
         column_result = numbers[0][column_index];
 
@@ -84,10 +91,9 @@ uint64_t day06_part1(void)
         }
         total_sum += column_result;
         column_index++;
-        action = strtok(NULL, " ");
     }
 
-    free(lines);
+    io_free_input(lines);
     return total_sum;
 }
 
@@ -111,13 +117,18 @@ uint64_t day06_part2(void)
 
     int len = strlen(lines[0]);
     uint32_t numbers[len];
-    for(int col_index = len; col_index >= 0; col_index--) {
-        char ascii_number[ROWS_WITH_NUMBERS];
+    for(int col_index = len - 1; col_index >= 0; col_index--) {
+        // The digits of a number are read top to bottom; blanks are skipped
+        uint32_t number = 0;
         for (size_t row_index = 0; row_index < ROWS_WITH_NUMBERS; row_index++)
         {
-            ascii_number[row_index] = lines[row_index][col_index];
+            char digit = lines[row_index][col_index];
+            if (digit >= '0' && digit <= '9')
+            {
+                number = (number * 10) + (uint32_t) (digit - '0');
+            }
         }
-        numbers[col_index] = atol(ascii_number);
+        numbers[col_index] = number;
     }
 
     char operator = lines[ROWS_WITH_NUMBERS][0];
@@ -147,6 +158,6 @@ uint64_t day06_part2(void)
         }
     }
     total_sum += problem;
-    free(lines);
+    io_free_input(lines);
     return total_sum;
 }
\ No newline at end of file
@@ -47,6 +47,7 @@ uint32_t day07_part1(void)
     if (0 == beam_start_index)
     {
         clog_error(__FILE_NAME__, "Cannot locate the start of the tachyon beam");
+        io_free_input(lines);
         return -EXIT_FAILURE;
     }
 
@@ -80,7 +81,7 @@ uint32_t day07_part1(void)
         }
     }
 
-    free(lines);
+    io_free_input(lines);
     return total_splits;
 }
 
@@ -163,6 +164,7 @@ uint64_t day07_part2(void)
     if (0 == beam_start_index)
     {
         clog_error(__FILE_NAME__, "Cannot locate the start of the tachyon beam");
+        io_free_input(lines);
         return -EXIT_FAILURE;
     }
 
@@ -179,6 +181,6 @@ uint64_t day07_part2(void)
     manifold_t manifold = {manifold_entries, strlen(lines[0]), line_count};
     uint64_t total_timelines = calculate_timelines(1, beam_start_index, &manifold);
 
-    free(lines);
+    io_free_input(lines);
     return total_timelines;
 }
@@ -0,0 +1,211 @@
+/*=====================================================================
+ * @file   interval.c
+ * @brief  Sets of uint64_t values stored as sorted, disjoint ranges.
+ * @details
+ * This module contains the construction of normalized interval sets
+ * (sort, then coalesce) and the union, clip, length and membership
+ * queries on them.
+ *
+ * @author R. Middel
+ * @date   2026-01-20
+ *
+ * @license
+ *      SPDX‑License-Identifier: MIT
+ *
+ *  @notes
+ *    * External dependencies:
+ *     - Standard C Library: For memory management.
+ *=====================================================================*/
+#include <stdlib.h>
+#include <string.h>
+
+#include "interval.h"
+#include "sort.h"
+
+/**
+ * @brief Coalesce ranges that are sorted by start, in place.
+ * Ranges that overlap or touch (end + 1 == start) become one.
+ * @param ranges non-empty ranges, sorted by start
+ * @param count  number of ranges
+ * @return size_t number of ranges left
+ */
+static size_t interval_coalesce(range_t* ranges, size_t count)
+{
+    if (0 == count)
+    {
+        return 0;
+    }
+
+    size_t last = 0;
+    for (size_t index = 1; index < count; index++)
+    {
+        /* Written as end >= start - 1, so end == UINT64_MAX cannot overflow */
+        if (ranges[index].start == 0 || ranges[last].end_including >= ranges[index].start - 1)
+        {
+            if (ranges[index].end_including > ranges[last].end_including)
+            {
+                ranges[last].end_including = ranges[index].end_including;
+            }
+        }
+        else
+        {
+            ranges[++last] = ranges[index];
+        }
+    }
+    return last + 1;
+}
+
+size_t interval_normalize(range_t* ranges, size_t count, range_t* scratch)
+{
+    size_t kept = 0;
+    for (size_t index = 0; index < count; index++)
+    {
+        if (ranges[index].start <= ranges[index].end_including)
+        {
+            ranges[kept++] = ranges[index];
+        }
+    }
+
+    parallel_sort_range(ranges, kept, scratch, 0);
+    return interval_coalesce(ranges, kept);
+}
+
+void interval_set_free(interval_set_t* set)
+{
+    free(set->ranges);
+    set->ranges = NULL;
+    set->count = 0;
+}
+
+uint32_t interval_set_build(interval_set_t* set, const range_t* ranges, size_t count)
+{
+    set->ranges = NULL;
+    set->count = 0;
+    if (0 == count)
+    {
+        return (uint32_t) EXIT_SUCCESS;
+    }
+
+    set->ranges = malloc(count * sizeof(range_t));
+    range_t* scratch = malloc(count * sizeof(range_t));
+    if (!set->ranges || !scratch)
+    {
+        free(scratch);
+        interval_set_free(set);
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    memcpy(set->ranges, ranges, count * sizeof(range_t));
+    set->count = interval_normalize(set->ranges, count, scratch);
+    free(scratch);
+    return (uint32_t) EXIT_SUCCESS;
+}
+
+uint32_t interval_set_union(interval_set_t* set, const interval_set_t* left, const interval_set_t* right)
+{
+    size_t count = left->count + right->count;
+    set->ranges = NULL;
+    set->count = 0;
+    if (0 == count)
+    {
+        return (uint32_t) EXIT_SUCCESS;
+    }
+
+    set->ranges = malloc(count * sizeof(range_t));
+    if (!set->ranges)
+    {
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    /* Merge the two sorted lists, then coalesce where they overlap */
+    size_t l = 0, r = 0, out = 0;
+    while (l < left->count || r < right->count)
+    {
+        if (r == right->count || (l < left->count && left->ranges[l].start <= right->ranges[r].start))
+        {
+            set->ranges[out++] = left->ranges[l++];
+        }
+        else
+        {
+            set->ranges[out++] = right->ranges[r++];
+        }
+    }
+    set->count = interval_coalesce(set->ranges, count);
+    return (uint32_t) EXIT_SUCCESS;
+}
+
+/**
+ * @brief Find the first range that ends at or after a value.
+ * @return size_t its index, or set->count when there is none
+ */
+static size_t interval_lower_bound(const interval_set_t* set, uint64_t value)
+{
+    size_t low = 0, high = set->count;
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if (set->ranges[middle].end_including < value)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+uint32_t interval_set_clip(interval_set_t* set, const interval_set_t* source, uint64_t first, uint64_t last)
+{
+    set->ranges = NULL;
+    set->count = 0;
+    if (first > last)
+    {
+        return (uint32_t) EXIT_SUCCESS;
+    }
+
+    size_t begin = interval_lower_bound(source, first);
+    size_t end = begin;
+    while (end < source->count && source->ranges[end].start <= last)
+    {
+        end++;
+    }
+    if (begin == end)
+    {
+        return (uint32_t) EXIT_SUCCESS;
+    }
+
+    set->ranges = malloc((end - begin) * sizeof(range_t));
+    if (!set->ranges)
+    {
+        return (uint32_t) EXIT_FAILURE;
+    }
+    memcpy(set->ranges, source->ranges + begin, (end - begin) * sizeof(range_t));
+    set->count = end - begin;
+    if (set->ranges[0].start < first)
+    {
+        set->ranges[0].start = first;
+    }
+    if (set->ranges[set->count - 1].end_including > last)
+    {
+        set->ranges[set->count - 1].end_including = last;
+    }
+    return (uint32_t) EXIT_SUCCESS;
+}
+
+__uint128_t interval_set_length(const interval_set_t* set)
+{
+    __uint128_t length = 0;
+    for (size_t index = 0; index < set->count; index++)
+    {
+        length += (__uint128_t) (set->ranges[index].end_including - set->ranges[index].start) + 1;
+    }
+    return length;
+}
+
+int interval_set_contains(const interval_set_t* set, uint64_t value)
+{
+    size_t index = interval_lower_bound(set, value);
+    return index < set->count && set->ranges[index].start <= value;
+}
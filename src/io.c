@@ -16,11 +16,256 @@
  *     - CLogger: For logging functionality.
  *     - Standard C Library: For input/output and standard utilities.
  *=====================================================================*/
+#define _GNU_SOURCE /* madvise() & friends under -std=c11 */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "aoc.h"
 #include "io.h"
 
+#ifdef AOC_HAVE_GZIP
+#include <zlib.h>
+#endif
+#ifdef AOC_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define IO_HAVE_X86 1
+#endif
+
+/* Line indexing ------------------------------------------------------- */
+
+/**
+ * @brief Checks (once per call) whether the CPU can run the AVX2 kernels.
+ * @return int Non-zero when AVX2 is available
+ */
+static int io_has_avx2(void)
+{
+#ifdef IO_HAVE_X86
+    return __builtin_cpu_supports("avx2");
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Emits one line view for every newline bit set in a mask.
+ * @param mask       Bit i is set when data[base + i] is a newline
+ * @param base       Offset of bit 0 in the buffer
+ * @param data       The buffer being indexed
+ * @param start      Offset of the first byte of the current line (updated)
+ * @param lines      The views to fill
+ * @param line_count Number of views filled so far (updated)
+ */
+static inline void io_emit_mask(uint64_t mask, size_t base, const char* data, size_t* start, io_line_t* lines,
+                                size_t* line_count)
+{
+    while (mask)
+    {
+        size_t newline = base + (size_t) __builtin_ctzll(mask);
+        lines[*line_count].data = data + *start;
+        lines[*line_count].length = newline - *start;
+        (*line_count)++;
+        *start = newline + 1;
+        mask &= mask - 1;
+    }
+}
+
+/**
+ * @brief Scalar newline counter, used for the tail and on other CPUs.
+ */
+static size_t io_count_newlines_scalar(const char* data, size_t size)
+{
+    size_t count = 0;
+    for (const char* cursor = data; (cursor = memchr(cursor, '\n', size - (size_t) (cursor - data))); cursor++)
+    {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Scalar line indexer, used for the tail and on other CPUs.
+ */
+static void io_index_lines_scalar(const char* data, size_t from, size_t size, size_t* start, io_line_t* lines,
+                                  size_t* line_count)
+{
+    for (size_t index = from; index < size; index++)
+    {
+        if ('\n' == data[index])
+        {
+            lines[*line_count].data = data + *start;
+            lines[*line_count].length = index - *start;
+            (*line_count)++;
+            *start = index + 1;
+        }
+    }
+}
+
+#ifdef __SSE2__
+/**
+ * @brief Counts newlines 16 bytes at a time (compare + movemask + popcount).
+ */
+static size_t io_count_newlines_sse2(const char* data, size_t size)
+{
+    const __m128i newline = _mm_set1_epi8('\n');
+    size_t count = 0;
+    size_t index = 0;
+
+    for (; index + 16 <= size; index += 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*) (data + index));
+        count += (size_t) __builtin_popcount((unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline)));
+    }
+    return count + io_count_newlines_scalar(data + index, size - index);
+}
+
+/**
+ * @brief Indexes lines 16 bytes at a time.
+ */
+static size_t io_index_lines_sse2(const char* data, size_t size, size_t* start, io_line_t* lines)
+{
+    const __m128i newline = _mm_set1_epi8('\n');
+    size_t line_count = 0;
+    size_t index = 0;
+
+    for (; index + 16 <= size; index += 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*) (data + index));
+        uint64_t mask = (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline));
+        io_emit_mask(mask, index, data, start, lines, &line_count);
+    }
+    io_index_lines_scalar(data, index, size, start, lines, &line_count);
+    return line_count;
+}
+#endif
+
+#ifdef IO_HAVE_X86
+/**
+ * @brief Counts newlines 64 bytes at a time using two AVX2 compares.
+ */
+__attribute__((target("avx2,popcnt"))) static size_t io_count_newlines_avx2(const char* data, size_t size)
+{
+    const __m256i newline = _mm256_set1_epi8('\n');
+    size_t count = 0;
+    size_t index = 0;
+
+    for (; index + 64 <= size; index += 64)
+    {
+        __m256i low = _mm256_loadu_si256((const __m256i*) (data + index));
+        __m256i high = _mm256_loadu_si256((const __m256i*) (data + index + 32));
+        uint64_t mask = (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(low, newline)) |
+                        ((uint64_t) (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(high, newline)) << 32);
+        count += (size_t) __builtin_popcountll(mask);
+    }
+    return count + io_count_newlines_scalar(data + index, size - index);
+}
+
+/**
+ * @brief Indexes lines 64 bytes at a time using two AVX2 compares.
+ */
+__attribute__((target("avx2,bmi"))) static size_t io_index_lines_avx2(const char* data, size_t size, size_t* start,
+                                                                       io_line_t* lines)
+{
+    const __m256i newline = _mm256_set1_epi8('\n');
+    size_t line_count = 0;
+    size_t index = 0;
+
+    for (; index + 64 <= size; index += 64)
+    {
+        __m256i low = _mm256_loadu_si256((const __m256i*) (data + index));
+        __m256i high = _mm256_loadu_si256((const __m256i*) (data + index + 32));
+        uint64_t mask = (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(low, newline)) |
+                        ((uint64_t) (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(high, newline)) << 32);
+        io_emit_mask(mask, index, data, start, lines, &line_count);
+    }
+    io_index_lines_scalar(data, index, size, start, lines, &line_count);
+    return line_count;
+}
+#endif
+
+/**
+ * @brief Counts the lines in a buffer.
+ * A last line without a trailing newline is counted as well.
+ * @param data The buffer to scan
+ * @param size The number of bytes in the buffer
+ * @return size_t The number of lines
+ */
+size_t io_count_lines(const char* data, size_t size)
+{
+    if (0 == size)
+    {
+        return 0;
+    }
+
+    size_t newlines;
+#ifdef IO_HAVE_X86
+    if (io_has_avx2())
+    {
+        newlines = io_count_newlines_avx2(data, size);
+    }
+    else
+#endif
+    {
+#ifdef __SSE2__
+        newlines = io_count_newlines_sse2(data, size);
+#else
+        newlines = io_count_newlines_scalar(data, size);
+#endif
+    }
+
+    return newlines + ('\n' != data[size - 1]);
+}
+
+/**
+ * @brief Builds the line table of a buffer.
+ * The buffer is scanned 64 (AVX2) or 16 (SSE2) bytes at a time and one
+ * view is emitted per line. The newline is not part of a view.
+ * @param data  The buffer to index
+ * @param size  The number of bytes in the buffer
+ * @param lines The views to fill; must hold io_count_lines(data, size) entries
+ * @return size_t The number of lines indexed
+ */
+size_t io_index_lines(const char* data, size_t size, io_line_t* lines)
+{
+    size_t start = 0;
+    size_t line_count;
+
+#ifdef IO_HAVE_X86
+    if (io_has_avx2())
+    {
+        line_count = io_index_lines_avx2(data, size, &start, lines);
+    }
+    else
+#endif
+    {
+#ifdef __SSE2__
+        line_count = io_index_lines_sse2(data, size, &start, lines);
+#else
+        line_count = 0;
+        io_index_lines_scalar(data, 0, size, &start, lines, &line_count);
+#endif
+    }
+
+    /* The last line does not need to end with a newline */
+    if (start < size)
+    {
+        lines[line_count].data = data + start;
+        lines[line_count].length = size - start;
+        line_count++;
+    }
+    return line_count;
+}
+
 /**
  * @brief Concatenates two strings with a '/' separator.
  * This function appends the source string to the destination string,
@@ -50,112 +295,1408 @@ char* io_strcat(char* dest, const char* src)
     return rdest;
 }
 
+/* Input selected with io_set_input() */
+static struct {
+    char path[IO_MAX_PATH_LEN]; /* replaces every input path when set */
+    int active;                 /* set while an input is selected */
+    char* content;              /* content of a stream, read once (NULL for regular files) */
+    size_t size;                /* size of content in bytes */
+} io_override;
+
 /**
- * @brief Reads input data from a specified file.
- * This function opens the file, reads its contents, and processes
- * the input data as required by the application.
- * @param filename The path to the input file.
- * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
+ * @brief Builds the full path of an input file.
+ * When an input was selected with io_set_input() its path is used instead.
+ * @param filename  The name of the input file (relative to AOC_PUZZLE_INPUT_PATH).
+ * @param full_path Buffer of IO_MAX_PATH_LEN bytes to store the path
+ * @return char* Pointer to full_path.
  */
-uint32_t io_read_input(const char* filename, char*** out_lines, size_t* out_line_count)
+char* io_input_path(const char* filename, char* full_path)
 {
-    char full_path[1024] = AOC_PUZZLE_INPUT_PATH;
-    io_strcat(full_path, filename);
-    clog_info(__FILE__, "Reading input from file: %s", full_path);
+    if (io_override.active)
+    {
+        snprintf(full_path, IO_MAX_PATH_LEN, "%s", io_override.path);
+        return full_path;
+    }
+    snprintf(full_path, IO_MAX_PATH_LEN, "%s", AOC_PUZZLE_INPUT_PATH);
+    return io_strcat(full_path, filename);
+}
+
+/* Decompression ------------------------------------------------------ */
+
+typedef enum {
+    IO_CODEC_PLAIN,
+    IO_CODEC_GZIP,
+    IO_CODEC_ZSTD
+} io_codec_t;
+
+/**
+ * @brief A file descriptor read through an optional decompressor.
+ * The first bytes are read ahead to recognise the compression format by
+ * its magic bytes; for plain files they are handed out before the rest.
+ */
+struct io_stream {
+    int fd;                 /* file being read (not owned) */
+    int cancel_fd;          /* readable once reading should stop, or -1 */
+    io_codec_t codec;       /* format recognised from the magic bytes */
+    unsigned char* input;   /* bytes read from fd, not yet consumed */
+    size_t input_pos;       /* first unconsumed byte in input */
+    size_t input_size;      /* number of valid bytes in input */
+    int input_eof;          /* set once fd is exhausted */
+    int finished;           /* set once the last compressed frame ended */
+#ifdef AOC_HAVE_GZIP
+    z_stream zlib;
+#endif
+#ifdef AOC_HAVE_ZSTD
+    ZSTD_DStream* zstd;
+#endif
+};
 
-    FILE* fp = fopen(full_path, "r");
-    if (!fp)
+/**
+ * @brief Recognises the compression format from the first bytes of a file.
+ * @param magic The first bytes of the file
+ * @param size  Number of bytes in magic
+ * @return io_codec_t The format (IO_CODEC_PLAIN when it is not compressed)
+ */
+static io_codec_t io_codec_detect(const unsigned char* magic, size_t size)
+{
+    if (size >= 2 && 0x1f == magic[0] && 0x8b == magic[1])
     {
-        clog_critical(__FILE__, "Failed to open file: %s", full_path);
-        return (uint32_t) EXIT_FAILURE;
+        return IO_CODEC_GZIP;
+    }
+    if (size >= 4 && 0x28 == magic[0] && 0xb5 == magic[1] && 0x2f == magic[2] && 0xfd == magic[3])
+    {
+        return IO_CODEC_ZSTD;
     }
+    return IO_CODEC_PLAIN;
+}
 
-    size_t capacity = INITIAL_CAPACITY;
-    char** lines = (char **)malloc(capacity * sizeof(char*));
-    if (!lines)
+/**
+ * @brief Reads raw bytes from the file of a stream.
+ * When the stream has a cancel_fd, the read waits for either descriptor,
+ * so a read blocked on a pipe or FIFO ends as soon as cancel_fd becomes
+ * readable.
+ * @return ssize_t The number of bytes read, 0 at the end of the file or -1 on error or cancellation.
+ */
+static ssize_t io_stream_read_fd(io_stream_t* stream, void* buffer, size_t capacity)
+{
+    if (stream->cancel_fd >= 0)
+    {
+        struct pollfd fds[2] = {{stream->cancel_fd, POLLIN, 0}, {stream->fd, POLLIN, 0}};
+        while (poll(fds, 2, -1) < 0)
+        {
+            if (EINTR != errno)
+            {
+                clog_critical(__FILE__, "Error while waiting for input");
+                return -1;
+            }
+        }
+        if (fds[0].revents)
+        {
+            return -1;
+        }
+    }
+
+    ssize_t bytes = read(stream->fd, buffer, capacity);
+    if (bytes < 0)
+    {
+        clog_critical(__FILE__, "Error while reading");
+    }
+    return bytes;
+}
+
+#if defined(AOC_HAVE_GZIP) || defined(AOC_HAVE_ZSTD)
+/**
+ * @brief Refills the (empty) input buffer of a stream from its file.
+ * @param stream The stream to refill
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
+ */
+static uint32_t io_stream_fill(io_stream_t* stream)
+{
+    ssize_t bytes = io_stream_read_fd(stream, stream->input, IO_STREAM_BUFFER_SIZE);
+    if (bytes < 0)
     {
-        fclose(fp);
         return (uint32_t) EXIT_FAILURE;
     }
+    stream->input_pos = 0;
+    stream->input_size = (size_t) bytes;
+    stream->input_eof = (0 == bytes);
+    return (uint32_t) EXIT_SUCCESS;
+}
+#endif
 
-    *out_line_count = 0;
-    char buf[MAX_LINE_LEN];
+/**
+ * @brief Starts reading a file, decompressing it when it is gzip or zstd.
+ * @param fd The file to read; it stays owned by the caller
+ * @return io_stream_t* The stream, or NULL on error (including a compressed
+ *         file when support for its format was not compiled in).
+ */
+static io_stream_t* io_stream_open(int fd)
+{
+    io_stream_t* stream = (io_stream_t*) calloc(1, sizeof(io_stream_t));
+    if (!stream || !(stream->input = (unsigned char*) malloc(IO_STREAM_BUFFER_SIZE)))
+    {
+        clog_critical(__FILE__, "Error malloc");
+        free(stream);
+        return NULL;
+    }
+    stream->fd = fd;
+    stream->cancel_fd = -1;
 
-    while (fgets(buf, sizeof buf, fp))
+    /* Read ahead until the magic bytes are known (or the file ended) */
+    while (stream->input_size < 4 && !stream->input_eof)
     {
-        if (*out_line_count == capacity)
+        ssize_t bytes = read(fd, stream->input + stream->input_size, IO_STREAM_BUFFER_SIZE - stream->input_size);
+        if (bytes < 0)
         {
-            capacity *= 2;
-            char** tmp = realloc(lines, capacity * sizeof(char *));
-            if (!tmp)
+            clog_critical(__FILE__, "Error while reading");
+            free(stream->input);
+            free(stream);
+            return NULL;
+        }
+        stream->input_eof = (0 == bytes);
+        stream->input_size += (size_t) bytes;
+    }
+
+    stream->codec = io_codec_detect(stream->input, stream->input_size);
+
+    int ready = 1;
+    switch (stream->codec)
+    {
+        case IO_CODEC_GZIP:
+#ifdef AOC_HAVE_GZIP
+            /* 15 window bits + 32: accept gzip (and zlib) headers */
+            ready = (Z_OK == inflateInit2(&stream->zlib, 15 + 32));
+#else
+            clog_critical(__FILE__, "Input is gzip compressed, but gzip support is disabled");
+            ready = 0;
+#endif
+            break;
+        case IO_CODEC_ZSTD:
+#ifdef AOC_HAVE_ZSTD
+            stream->zstd = ZSTD_createDStream();
+            ready = (NULL != stream->zstd) && !ZSTD_isError(ZSTD_initDStream(stream->zstd));
+#else
+            clog_critical(__FILE__, "Input is zstd compressed, but zstd support is disabled");
+            ready = 0;
+#endif
+            break;
+        default:
+            break;
+    }
+
+    if (!ready)
+    {
+#ifdef AOC_HAVE_ZSTD
+        ZSTD_freeDStream(stream->zstd);
+#endif
+        free(stream->input);
+        free(stream);
+        return NULL;
+    }
+    return stream;
+}
+
+#ifdef AOC_HAVE_GZIP
+/**
+ * @brief Inflates gzip data into a buffer.
+ * Concatenated gzip members are decompressed one after another.
+ */
+static ssize_t io_stream_read_gzip(io_stream_t* stream, char* buffer, size_t capacity)
+{
+    z_stream* zlib = &stream->zlib;
+    zlib->next_out = (Bytef*) buffer;
+    zlib->avail_out = (uInt) (capacity > UINT32_MAX ? UINT32_MAX : capacity);
+    uInt available = zlib->avail_out;
+
+    while (zlib->avail_out == available && !stream->finished)
+    {
+        if (stream->input_pos == stream->input_size && !stream->input_eof && EXIT_FAILURE == io_stream_fill(stream))
+        {
+            return -1;
+        }
+
+        zlib->next_in = stream->input + stream->input_pos;
+        zlib->avail_in = (uInt) (stream->input_size - stream->input_pos);
+        int status = inflate(zlib, Z_NO_FLUSH);
+        stream->input_pos = stream->input_size - zlib->avail_in;
+
+        if (Z_STREAM_END == status)
+        {
+            /* Another member may follow */
+            if (stream->input_pos == stream->input_size && !stream->input_eof &&
+                EXIT_FAILURE == io_stream_fill(stream))
             {
-                clog_critical(__FILE__, "Error realloc");
-                fclose(fp);
-                return (uint32_t) EXIT_FAILURE;
+                return -1;
             }
-            lines = tmp;
+            if (stream->input_pos == stream->input_size)
+            {
+                stream->finished = 1;
+            }
+            else
+            {
+                inflateReset(zlib);
+            }
+        }
+        else if (Z_BUF_ERROR == status && stream->input_eof && stream->input_pos == stream->input_size)
+        {
+            clog_critical(__FILE__, "Truncated gzip input");
+            return -1;
+        }
+        else if (Z_OK != status && Z_BUF_ERROR != status)
+        {
+            clog_critical(__FILE__, "Corrupt gzip input: %s", zlib->msg ? zlib->msg : "unknown error");
+            return -1;
+        }
+    }
+    return (ssize_t) (available - zlib->avail_out);
+}
+#endif
+
+#ifdef AOC_HAVE_ZSTD
+/**
+ * @brief Decompresses zstd data into a buffer.
+ * Concatenated frames are decompressed one after another.
+ */
+static ssize_t io_stream_read_zstd(io_stream_t* stream, char* buffer, size_t capacity)
+{
+    ZSTD_outBuffer output = {buffer, capacity, 0};
+
+    while (0 == output.pos && !stream->finished)
+    {
+        if (stream->input_pos == stream->input_size && !stream->input_eof && EXIT_FAILURE == io_stream_fill(stream))
+        {
+            return -1;
         }
 
-        /* strip trailing newline if you don’t want it */
-        size_t len = strlen(buf);
-        if (len && buf[len - 1] == '\n')
-            buf[len - 1] = '\0';
+        ZSTD_inBuffer input = {stream->input, stream->input_size, stream->input_pos};
+        size_t status = ZSTD_decompressStream(stream->zstd, &output, &input);
+        stream->input_pos = input.pos;
+        if (ZSTD_isError(status))
+        {
+            clog_critical(__FILE__, "Corrupt zstd input: %s", ZSTD_getErrorName(status));
+            return -1;
+        }
 
-        lines[*out_line_count] = (char *)malloc(MAX_LINE_LEN * sizeof(char));
-        strncpy(lines[*out_line_count], buf, MAX_LINE_LEN);
-        (*out_line_count)++;
+        if (0 == status)
+        {
+            /* A frame just ended; another one may follow */
+            if (stream->input_pos == stream->input_size && !stream->input_eof &&
+                EXIT_FAILURE == io_stream_fill(stream))
+            {
+                return -1;
+            }
+            stream->finished = stream->input_pos == stream->input_size && stream->input_eof;
+        }
+        else if (0 == output.pos && stream->input_eof && stream->input_pos == stream->input_size)
+        {
+            clog_critical(__FILE__, "Truncated zstd input");
+            return -1;
+        }
     }
+    return (ssize_t) output.pos;
+}
+#endif
 
-    if (ferror(fp))
+/**
+ * @brief Reads (decompressed) bytes from a stream.
+ * @param stream   The stream to read from
+ * @param buffer   The buffer to fill
+ * @param capacity The size of buffer in bytes
+ * @return ssize_t The number of bytes read, 0 at the end of the input or -1 on error.
+ */
+static ssize_t io_stream_read(io_stream_t* stream, char* buffer, size_t capacity)
+{
+    if (0 == capacity)
     {
-        clog_critical(__FILE__, "Error while reading");
-        perror("Error while reading");
-        fclose(fp);
-        return (uint32_t) EXIT_FAILURE;
+        return 0;
+    }
+    switch (stream->codec)
+    {
+#ifdef AOC_HAVE_GZIP
+        case IO_CODEC_GZIP:
+            return io_stream_read_gzip(stream, buffer, capacity);
+#endif
+#ifdef AOC_HAVE_ZSTD
+        case IO_CODEC_ZSTD:
+            return io_stream_read_zstd(stream, buffer, capacity);
+#endif
+        default:
+            break;
     }
 
-    fclose(fp);
-    *out_lines = lines;
-    return (uint32_t) EXIT_SUCCESS;
+    /* Plain input: hand out the bytes read ahead first */
+    if (stream->input_pos < stream->input_size)
+    {
+        size_t available = stream->input_size - stream->input_pos;
+        size_t bytes = available < capacity ? available : capacity;
+        memcpy(buffer, stream->input + stream->input_pos, bytes);
+        stream->input_pos += bytes;
+        return (ssize_t) bytes;
+    }
+    if (stream->input_eof)
+    {
+        return 0;
+    }
+    return io_stream_read_fd(stream, buffer, capacity);
 }
 
+/**
+ * @brief Releases a stream opened with io_stream_open().
+ * The file descriptor is not closed.
+ * @param stream The stream to release (may be NULL)
+ */
+static void io_stream_close(io_stream_t* stream)
+{
+    if (NULL == stream)
+    {
+        return;
+    }
+#ifdef AOC_HAVE_GZIP
+    if (IO_CODEC_GZIP == stream->codec)
+    {
+        inflateEnd(&stream->zlib);
+    }
+#endif
+#ifdef AOC_HAVE_ZSTD
+    ZSTD_freeDStream(stream->zstd);
+#endif
+    free(stream->input);
+    free(stream);
+}
 
 /**
- * @brief Reads input data from a specified file.
- * This function opens the file, reads its contents, and processes
- * the input data as required by the application.
- * @param filename The path to the input file.
- * @param grid     A reference to the grid to fill
+ * @brief Reads the complete content of an open file into one buffer.
+ * gzip and zstd compressed files are decompressed on the fly. The buffer
+ * grows when the content turns out to be larger than expected, so this
+ * also works when the size is not known up front.
+ * @param fd       The file descriptor to read from
+ * @param reserve  Number of extra bytes to keep free behind the content
+ * @param out_data Pointer to store the allocated buffer
+ * @param out_size Pointer to store the number of bytes read
  * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
  */
-uint32_t io_read_grid(const char* filename, grid_t* grid) {
-
-    char** lines = NULL;
-    size_t line_count = 0;
+static uint32_t io_read_all(int fd, size_t reserve, char** out_data, size_t* out_size)
+{
+    io_stream_t* stream = io_stream_open(fd);
+    if (!stream)
+    {
+        return (uint32_t) EXIT_FAILURE;
+    }
 
-    if (EXIT_FAILURE == io_read_input(filename, &lines, &line_count))
+    struct stat st;
+    size_t capacity = MAX_LINE_LEN;
+    if (0 == fstat(fd, &st) && st.st_size > 0)
     {
-        return -EXIT_FAILURE;
+        /*
+         * A plain file gets one spare byte, so the read that finds the end
+         * of the file does not grow the buffer. Puzzle inputs compress
+         * well; guess the decompressed size.
+         */
+        capacity = IO_CODEC_PLAIN == stream->codec ? (size_t) st.st_size + 1 : (size_t) st.st_size * 4;
     }
 
-    grid->columns = strlen(lines[0]);
-    grid->rows = line_count;
-    grid->cells = malloc(line_count * sizeof(char) * grid->columns);
+    char* data = (char*) malloc(capacity + reserve);
+    if (!data)
+    {
+        clog_critical(__FILE__, "Error malloc");
+        io_stream_close(stream);
+        return (uint32_t) EXIT_FAILURE;
+    }
 
-    if (!grid->cells)
+    size_t size = 0;
+    for (;;)
     {
-        perror("malloc");
-        return EXIT_FAILURE;
+        if (size == capacity)
+        {
+            capacity *= 2;
+            char* tmp = realloc(data, capacity + reserve);
+            if (!tmp)
+            {
+                clog_critical(__FILE__, "Error realloc");
+                free(data);
+                io_stream_close(stream);
+                return (uint32_t) EXIT_FAILURE;
+            }
+            data = tmp;
+        }
+
+        ssize_t bytes = io_stream_read(stream, data + size, capacity - size);
+        if (bytes < 0)
+        {
+            clog_critical(__FILE__, "Error while reading");
+            free(data);
+            io_stream_close(stream);
+            return (uint32_t) EXIT_FAILURE;
+        }
+        if (0 == bytes)
+        {
+            break;
+        }
+        size += (size_t) bytes;
     }
-    /* Copy rows into the contiguous buffer (row‑major order) */
-    for (size_t r = 0; r < line_count; ++r)
+
+    io_stream_close(stream);
+    *out_data = data;
+    *out_size = size;
+    return (uint32_t) EXIT_SUCCESS;
+}
+
+/* Input selection ---------------------------------------------------- */
+
+/**
+ * @brief Selects the input used by all loaders instead of the puzzle input files.
+ * @param path The input file, "-" for stdin, or NULL to go back to AOC_PUZZLE_INPUT_PATH
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
+ */
+uint32_t io_set_input(const char* path)
+{
+    free(io_override.content);
+    memset(&io_override, 0, sizeof(io_override));
+    if (NULL == path)
     {
-        memcpy(grid->cells + r * grid->columns, lines[r], grid->columns);
+        return (uint32_t) EXIT_SUCCESS;
     }
 
-    /* Clean up the temporary per‑line storage */
-    for (size_t index = 0; index < line_count; index++) free(lines[index]);
-    free(lines);
+    int is_stdin = 0 == strcmp(path, "-");
+    int fd = is_stdin ? STDIN_FILENO : open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        clog_critical(__FILE__, "Failed to open file: %s", path);
+        return (uint32_t) EXIT_FAILURE;
+    }
 
-    return (uint32_t) EXIT_SUCCESS;
- }
\ No newline at end of file
+    /*
+     * A pipe can be read only once and cannot be mapped, while every part
+     * loads its input again. Streams (and stdin, which cannot be reopened
+     * by name) are therefore read into memory here and handed to the
+     * loaders instead of a file.
+     */
+    struct stat st;
+    uint32_t result = (uint32_t) EXIT_SUCCESS;
+    if (is_stdin || 0 != fstat(fd, &st) || !S_ISREG(st.st_mode))
+    {
+        clog_info(__FILE__, "Reading input stream: %s", path);
+        result = io_read_all(fd, 0, &io_override.content, &io_override.size);
+    }
+    if (!is_stdin)
+    {
+        close(fd);
+    }
+    if (EXIT_FAILURE == result)
+    {
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    snprintf(io_override.path, sizeof(io_override.path), "%s", path);
+    io_override.active = 1;
+    return (uint32_t) EXIT_SUCCESS;
+}
+
+/**
+ * @brief Tells whether the selected input is a stream held in memory.
+ * @return int Non-zero for stdin and pipes, 0 for regular files
+ */
+int io_input_is_stream(void)
+{
+    return NULL != io_override.content;
+}
+
+/* Prefetching -------------------------------------------------------- */
+
+static struct {
+    pthread_mutex_t lock; /* guards stop */
+    pthread_t thread;
+    int running;          /* set while the thread exists */
+    int stop;             /* asks the thread to skip the remaining files */
+    size_t count;
+    char filenames[IO_PREFETCH_MAX_FILES][IO_MAX_PATH_LEN]; /* relative to AOC_PUZZLE_INPUT_PATH */
+} io_prefetch = {.lock = PTHREAD_MUTEX_INITIALIZER};
+
+/**
+ * @brief Background thread pulling the files into the page cache one after another.
+ * Nothing is copied into the process: the loaders read (or map) the files
+ * as usual and find them cached by the kernel.
+ * @param argument Unused
+ * @return void* Always NULL
+ */
+static void* io_prefetch_thread(void* argument)
+{
+    (void) argument;
+
+    for (size_t index = 0; index < io_prefetch.count; index++)
+    {
+        char full_path[IO_MAX_PATH_LEN];
+
+        pthread_mutex_lock(&io_prefetch.lock);
+        int stop = io_prefetch.stop;
+        pthread_mutex_unlock(&io_prefetch.lock);
+        if (stop)
+        {
+            break;
+        }
+
+        int fd = open(io_input_path(io_prefetch.filenames[index], full_path), O_RDONLY);
+        if (fd < 0)
+        {
+            continue;
+        }
+        struct stat st;
+        if (0 == fstat(fd, &st) && S_ISREG(st.st_mode))
+        {
+#ifdef __linux__
+            /* Blocks until the file is read, so the files arrive in order */
+            readahead(fd, 0, (size_t) st.st_size);
+#else
+            posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+#endif
+        }
+        close(fd);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Starts pulling input files into the page cache in the background.
+ * @param filenames The names of the input files (relative to AOC_PUZZLE_INPUT_PATH)
+ * @param count     Number of entries in filenames (at most IO_PREFETCH_MAX_FILES)
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
+ */
+uint32_t io_prefetch_start(const char* const* filenames, size_t count)
+{
+    if (io_prefetch.running || count > IO_PREFETCH_MAX_FILES)
+    {
+        clog_error(__FILE__, "Cannot prefetch %zu files", count);
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    for (size_t index = 0; index < count; index++)
+    {
+        snprintf(io_prefetch.filenames[index], sizeof(io_prefetch.filenames[index]), "%s", filenames[index]);
+    }
+    io_prefetch.count = count;
+    io_prefetch.stop = 0;
+
+    if (0 != pthread_create(&io_prefetch.thread, NULL, io_prefetch_thread, NULL))
+    {
+        clog_error(__FILE__, "Failed to start the prefetch thread");
+        io_prefetch.count = 0;
+        return (uint32_t) EXIT_FAILURE;
+    }
+    io_prefetch.running = 1;
+    clog_info(__FILE__, "Prefetching %zu input files", count);
+    return (uint32_t) EXIT_SUCCESS;
+}
+
+/**
+ * @brief Stops the background thread.
+ */
+void io_prefetch_stop(void)
+{
+    if (!io_prefetch.running)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&io_prefetch.lock);
+    io_prefetch.stop = 1;
+    pthread_mutex_unlock(&io_prefetch.lock);
+    pthread_join(io_prefetch.thread, NULL);
+
+    io_prefetch.count = 0;
+    io_prefetch.running = 0;
+}
+
+/**
+ * @brief Looks up the content of the selected input stream (see io_set_input()).
+ * @param data Pointer to store the content
+ * @param size Pointer to store the size of the content
+ * @return uint32_t EXIT_SUCCESS when a stream is held in memory, or EXIT_FAILURE
+ *         when the input has to be read from its file.
+ */
+static uint32_t io_override_content(const char** data, size_t* size)
+{
+    if (!io_input_is_stream())
+    {
+        return (uint32_t) EXIT_FAILURE;
+    }
+    *data = io_override.content;
+    *size = io_override.size;
+    return (uint32_t) EXIT_SUCCESS;
+}
+
+/**
+ * @brief Reads input data from a specified file.
+ * The complete file is read into a single arena (decompressing gzip and
+ * zstd files on the way). Every line is stored at its exact length
+ * (NUL-terminated, without the newline) and the line table lives in the
+ * same allocation, so loading costs O(1) allocations.
+ * Release the result with io_free_input().
+ * @param filename The path to the input file.
+ * @param out_lines Pointer to store the array of lines
+ * @param out_line_count Pointer to store the number of lines read
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
+ */
+uint32_t io_read_input(const char* filename, char*** out_lines, size_t* out_line_count)
+{
+    char full_path[IO_MAX_PATH_LEN];
+    io_input_path(filename, full_path);
+    clog_info(__FILE__, "Reading input from file: %s", full_path);
+
+    char* data = NULL;
+    size_t size = 0;
+    const char* content;
+    if (EXIT_SUCCESS == io_override_content(&content, &size))
+    {
+        /* The lines are NUL-terminated in place, so the stream needs a copy */
+        data = (char*) malloc(size + 1);
+        if (!data)
+        {
+            clog_critical(__FILE__, "Error malloc");
+            return (uint32_t) EXIT_FAILURE;
+        }
+        memcpy(data, content, size);
+    }
+    else
+    {
+        int fd = open(full_path, O_RDONLY);
+        if (fd < 0)
+        {
+            clog_critical(__FILE__, "Failed to open file: %s", full_path);
+            return (uint32_t) EXIT_FAILURE;
+        }
+
+        uint32_t result = io_read_all(fd, 1, &data, &size);
+        close(fd);
+        if (EXIT_FAILURE == result)
+        {
+            return (uint32_t) EXIT_FAILURE;
+        }
+    }
+
+    /*
+     * The line table is appended to the arena: [content][NUL][pad][arena][lines...]
+     * The first slot points back at the arena so io_free_input() can find it.
+     * The line views are indexed into the same space first, so the table
+     * region is sized for whichever of the two is larger.
+     */
+    size_t line_count = io_count_lines(data, size);
+    size_t table_offset = (size + 1 + sizeof(char*) - 1) & ~(sizeof(char*) - 1);
+    size_t table_size = (line_count + 1) * sizeof(char*);
+    if (table_size < line_count * sizeof(io_line_t))
+    {
+        table_size = line_count * sizeof(io_line_t);
+    }
+    char* arena = realloc(data, table_offset + table_size);
+    if (!arena)
+    {
+        clog_critical(__FILE__, "Error realloc");
+        free(data);
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    /*
+     * Turn the views into NUL-terminated lines inside the arena. Slot
+     * index + 1 of the table ends before view index + 1 begins, so every
+     * view is read before its bytes are overwritten.
+     */
+    io_line_t* views = (io_line_t*) (arena + table_offset);
+    char** table = (char**) (arena + table_offset);
+    io_index_lines(arena, size, views);
+    for (size_t index = 0; index < line_count; index++)
+    {
+        char* line = (char*) views[index].data;
+        size_t length = views[index].length;
+        line[length] = '\0';
+        table[index + 1] = line;
+    }
+    table[0] = arena;
+    arena[size] = '\0';
+
+    *out_lines = table + 1;
+    *out_line_count = line_count;
+    return (uint32_t) EXIT_SUCCESS;
+}
+
+/**
+ * @brief Releases the lines returned by io_read_input().
+ * This frees the line table and the storage of every line in one go.
+ * @param lines The array of lines to release (may be NULL)
+ */
+void io_free_input(char** lines)
+{
+    if (NULL == lines)
+    {
+        return;
+    }
+    free(lines[-1]);
+}
+
+
+/**
+ * @brief Reads a grid from a specified file.
+ * The rows are copied straight from the mapped file into a single
+ * 64-byte aligned buffer. Every row is padded to a stride that is a
+ * multiple of 64 bytes and the grid is surrounded by a one-cell ring of
+ * GRID_SENTINEL cells, so grid->cells[r * stride + c] is valid for every
+ * r in [-1, rows] and c in [-1, columns]. Release it with io_free_grid().
+ * @param filename The path to the input file.
+ * @param grid     A reference to the grid to fill
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
+ */
+uint32_t io_read_grid(const char* filename, grid_t* grid)
+{
+    io_mapped_input_t input;
+
+    memset(grid, 0, sizeof(*grid));
+    if (EXIT_FAILURE == io_map_input(filename, &input))
+    {
+        return (uint32_t) EXIT_FAILURE;
+    }
+    if (0 == input.line_count)
+    {
+        clog_critical(__FILE__, "Grid %s is empty", filename);
+        io_unmap_input(&input);
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    /*
+     * The padding behind every row (at least one cell) doubles as the right
+     * sentinel of that row and the left sentinel of the next row. One extra
+     * aligned block in front holds the left sentinel of the top ring row.
+     */
+    size_t columns = input.lines[0].length;
+    size_t stride = (columns + 1 + GRID_ALIGNMENT - 1) & ~((size_t) GRID_ALIGNMENT - 1);
+    size_t buffer_size = GRID_ALIGNMENT + (input.line_count + 2) * stride;
+
+    char* buffer = aligned_alloc(GRID_ALIGNMENT, buffer_size);
+    if (!buffer)
+    {
+        clog_critical(__FILE__, "Error aligned_alloc");
+        io_unmap_input(&input);
+        return (uint32_t) EXIT_FAILURE;
+    }
+    memset(buffer, GRID_SENTINEL, buffer_size);
+
+    /* Copy rows into the contiguous buffer (row‑major order) */
+    char* cells = buffer + GRID_ALIGNMENT + stride;
+    for (size_t r = 0; r < input.line_count; ++r)
+    {
+        size_t length = input.lines[r].length < columns ? input.lines[r].length : columns;
+        memcpy(cells + r * stride, input.lines[r].data, length);
+    }
+
+    grid->cells = cells;
+    grid->columns = (uint32_t) columns;
+    grid->rows = (uint32_t) input.line_count;
+    grid->stride = (uint32_t) stride;
+    grid->buffer = buffer;
+    grid->buffer_size = buffer_size;
+
+    io_unmap_input(&input);
+    return (uint32_t) EXIT_SUCCESS;
+}
+
+/**
+ * @brief Releases a grid read by io_read_grid().
+ * @param grid The grid to release
+ */
+void io_free_grid(grid_t* grid)
+{
+    if (NULL == grid)
+    {
+        return;
+    }
+    free(grid->buffer);
+    memset(grid, 0, sizeof(*grid));
+}
+
+/**
+ * @brief Builds the line views of an input held in memory.
+ * @param input The input to fill
+ * @param data  The content of the input
+ * @param size  The size of the content in bytes
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
+ */
+static uint32_t io_index_input(io_mapped_input_t* input, const char* data, size_t size)
+{
+    /* Count first so the views need a single allocation */
+    size_t line_count = io_count_lines(data, size);
+    io_line_t* lines = (io_line_t*) malloc((line_count ? line_count : 1) * sizeof(io_line_t));
+    if (!lines)
+    {
+        clog_critical(__FILE__, "Error malloc");
+        return (uint32_t) EXIT_FAILURE;
+    }
+    io_index_lines(data, size, lines);
+
+    input->data = size ? data : NULL;
+    input->size = size;
+    input->lines = lines;
+    input->line_count = line_count;
+    return (uint32_t) EXIT_SUCCESS;
+}
+
+/**
+ * @brief Maps an input file into memory without copying it.
+ * The file is mapped read-only and split into line views that point
+ * directly into the mapping. Nothing is copied and no per-line memory
+ * is allocated. A selected input stream is used in place instead of
+ * being mapped. Release everything with io_unmap_input().
+ * @param filename The name of the input file (relative to AOC_PUZZLE_INPUT_PATH).
+ * @param input    The mapped input to fill
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
+ */
+uint32_t io_map_input(const char* filename, io_mapped_input_t* input)
+{
+    char full_path[IO_MAX_PATH_LEN];
+    io_input_path(filename, full_path);
+    clog_info(__FILE__, "Mapping input from file: %s", full_path);
+
+    memset(input, 0, sizeof(*input));
+
+    const char* content;
+    size_t size;
+    if (EXIT_SUCCESS == io_override_content(&content, &size))
+    {
+        return io_index_input(input, content, size);
+    }
+
+    int fd = open(full_path, O_RDONLY);
+    if (fd < 0)
+    {
+        clog_critical(__FILE__, "Failed to open file: %s", full_path);
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        clog_critical(__FILE__, "Failed to stat file: %s", full_path);
+        close(fd);
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    /* An empty file cannot be mapped, but it is a valid (empty) input */
+    if (0 == st.st_size)
+    {
+        close(fd);
+        return (uint32_t) EXIT_SUCCESS;
+    }
+
+    /* A compressed file cannot be used in place; decompress it into memory */
+    unsigned char magic[4];
+    ssize_t magic_size = pread(fd, magic, sizeof(magic), 0);
+    if (magic_size > 0 && IO_CODEC_PLAIN != io_codec_detect(magic, (size_t) magic_size))
+    {
+        char* buffer = NULL;
+        uint32_t result = io_read_all(fd, 0, &buffer, &size);
+        close(fd);
+        if (EXIT_FAILURE == result || EXIT_FAILURE == io_index_input(input, buffer, size))
+        {
+            free(buffer);
+            return (uint32_t) EXIT_FAILURE;
+        }
+        input->buffer = buffer;
+        return (uint32_t) EXIT_SUCCESS;
+    }
+
+    size = (size_t) st.st_size;
+    void* mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); /* the mapping keeps its own reference to the file */
+    if (MAP_FAILED == mapping)
+    {
+        clog_critical(__FILE__, "Failed to map file: %s", full_path);
+        return (uint32_t) EXIT_FAILURE;
+    }
+    madvise(mapping, size, MADV_SEQUENTIAL);
+
+    if (EXIT_FAILURE == io_index_input(input, (const char*) mapping, size))
+    {
+        munmap(mapping, size);
+        return (uint32_t) EXIT_FAILURE;
+    }
+    input->mapping = mapping;
+    return (uint32_t) EXIT_SUCCESS;
+}
+
+/**
+ * @brief Releases an input mapped by io_map_input().
+ * All line views become invalid after this call.
+ * @param input The mapped input to release
+ */
+void io_unmap_input(io_mapped_input_t* input)
+{
+    if (NULL == input)
+    {
+        return;
+    }
+    if (input->mapping)
+    {
+        munmap(input->mapping, input->size);
+    }
+    free(input->buffer);
+    free(input->lines);
+    memset(input, 0, sizeof(*input));
+}
+
+/* Pipelined reading -------------------------------------------------- */
+
+/**
+ * @brief A reader thread filling a ring of chunks for the parsing thread.
+ * The ring is a single-producer/single-consumer queue: the producer only
+ * advances head, the consumer only advances tail, and chunk i lives in
+ * slot i % IO_PIPELINE_CHUNKS. A chunk of size 0 marks the end of the input.
+ * Both sides sleep on a condition variable while the ring is full or empty.
+ */
+struct io_pipeline {
+    io_stream_t* stream;                   /* read by the producer only */
+    char* chunks[IO_PIPELINE_CHUNKS];      /* the ring of chunk buffers */
+    size_t sizes[IO_PIPELINE_CHUNKS];      /* valid bytes in every chunk */
+    pthread_mutex_t lock;                  /* guards head, tail, stop and error */
+    pthread_cond_t produced;               /* signalled when head advances */
+    pthread_cond_t released;               /* signalled when tail advances or stop is set */
+    size_t head;                           /* number of chunks produced */
+    size_t tail;                           /* number of chunks released by the consumer */
+    int stop;                              /* asks the producer to quit early */
+    int error;                             /* set when reading failed */
+    int wake[2];                           /* pipe waking the producer from a blocking read */
+    pthread_t thread;
+    int holding;                           /* consumer holds chunk tail */
+    size_t position;                       /* consumer: next byte to scan in chunk tail */
+};
+
+/**
+ * @brief Producer: reads the input into the chunks of the ring.
+ * @param argument The pipeline
+ * @return void* Always NULL
+ */
+static void* io_pipeline_thread(void* argument)
+{
+    io_pipeline_t* pipeline = (io_pipeline_t*) argument;
+
+    for (size_t head = 0;; head++)
+    {
+        /* Wait for a free slot */
+        pthread_mutex_lock(&pipeline->lock);
+        while (head - pipeline->tail == IO_PIPELINE_CHUNKS && !pipeline->stop)
+        {
+            pthread_cond_wait(&pipeline->released, &pipeline->lock);
+        }
+        int stop = pipeline->stop;
+        pthread_mutex_unlock(&pipeline->lock);
+        if (stop)
+        {
+            return NULL;
+        }
+
+        /*
+         * A chunk holds what one read returns, so a pipe delivers its lines
+         * as soon as they arrive. A stop request makes a blocked read fail,
+         * which ends the input.
+         */
+        size_t slot = head % IO_PIPELINE_CHUNKS;
+        ssize_t bytes = io_stream_read(pipeline->stream, pipeline->chunks[slot], IO_PIPELINE_CHUNK_SIZE);
+        size_t size = bytes > 0 ? (size_t) bytes : 0;
+
+        pthread_mutex_lock(&pipeline->lock);
+        pipeline->sizes[slot] = size;
+        pipeline->error = bytes < 0;
+        pipeline->head = head + 1;
+        pthread_cond_signal(&pipeline->produced);
+        pthread_mutex_unlock(&pipeline->lock);
+        if (0 == size)
+        {
+            return NULL;
+        }
+    }
+}
+
+/**
+ * @brief Releases the resources of a pipeline whose thread is not running.
+ * @param pipeline The pipeline to release
+ */
+static void io_pipeline_free(io_pipeline_t* pipeline)
+{
+    pipeline->stream->cancel_fd = -1;
+    close(pipeline->wake[0]);
+    close(pipeline->wake[1]);
+    pthread_cond_destroy(&pipeline->released);
+    pthread_cond_destroy(&pipeline->produced);
+    pthread_mutex_destroy(&pipeline->lock);
+    for (size_t index = 0; index < IO_PIPELINE_CHUNKS; index++)
+    {
+        free(pipeline->chunks[index]);
+    }
+    free(pipeline);
+}
+
+/**
+ * @brief Starts the reader thread of a pipeline on a stream.
+ * @param stream The stream to read; it is used by the reader thread only
+ * @return io_pipeline_t* The pipeline, or NULL on error.
+ */
+static io_pipeline_t* io_pipeline_start(io_stream_t* stream)
+{
+    io_pipeline_t* pipeline = (io_pipeline_t*) calloc(1, sizeof(io_pipeline_t));
+    if (!pipeline)
+    {
+        return NULL;
+    }
+    if (0 != pipe(pipeline->wake))
+    {
+        free(pipeline);
+        return NULL;
+    }
+    pipeline->stream = stream;
+    pthread_mutex_init(&pipeline->lock, NULL);
+    pthread_cond_init(&pipeline->produced, NULL);
+    pthread_cond_init(&pipeline->released, NULL);
+    stream->cancel_fd = pipeline->wake[0];
+
+    int ready = 1;
+    for (size_t index = 0; index < IO_PIPELINE_CHUNKS; index++)
+    {
+        pipeline->chunks[index] = (char*) malloc(IO_PIPELINE_CHUNK_SIZE);
+        ready = ready && NULL != pipeline->chunks[index];
+    }
+    if (!ready || 0 != pthread_create(&pipeline->thread, NULL, io_pipeline_thread, pipeline))
+    {
+        io_pipeline_free(pipeline);
+        return NULL;
+    }
+    return pipeline;
+}
+
+/**
+ * @brief Stops the reader thread of a pipeline and releases it.
+ * A producer blocked on a full ring is woken through the condition
+ * variable, one blocked in read() through the wake pipe.
+ * @param pipeline The pipeline to release (may be NULL)
+ */
+static void io_pipeline_stop(io_pipeline_t* pipeline)
+{
+    if (NULL == pipeline)
+    {
+        return;
+    }
+    pthread_mutex_lock(&pipeline->lock);
+    pipeline->stop = 1;
+    pthread_cond_signal(&pipeline->released);
+    pthread_mutex_unlock(&pipeline->lock);
+    if (write(pipeline->wake[1], "", 1) < 0)
+    {
+        clog_error(__FILE__, "Failed to wake the reader thread");
+    }
+    pthread_join(pipeline->thread, NULL);
+    io_pipeline_free(pipeline);
+}
+
+/**
+ * @brief Appends bytes to the line the reader is assembling in its buffer.
+ * @param reader The reader
+ * @param data   The bytes to append
+ * @param length Number of bytes to append
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
+ */
+static uint32_t io_reader_carry(io_line_reader_t* reader, const char* data, size_t length)
+{
+    /* Always keep one byte free to NUL-terminate the line */
+    if (reader->end + length + 1 > reader->capacity)
+    {
+        size_t capacity = reader->capacity;
+        while (reader->end + length + 1 > capacity)
+        {
+            capacity *= 2;
+        }
+        char* tmp = realloc(reader->buffer, capacity);
+        if (!tmp)
+        {
+            clog_critical(__FILE__, "Error realloc");
+            return (uint32_t) EXIT_FAILURE;
+        }
+        reader->buffer = tmp;
+        reader->capacity = capacity;
+    }
+    memcpy(reader->buffer + reader->end, data, length);
+    reader->end += length;
+    return (uint32_t) EXIT_SUCCESS;
+}
+
+/**
+ * @brief Consumer: hands out the next line from the chunks of the pipeline.
+ * Lines are handed out in place (the newline becomes a NUL). Only a line
+ * that straddles two chunks, or ends the input without a newline, is
+ * assembled in the reader's buffer.
+ * @param reader The reader to read from
+ * @param line   The view to fill
+ * @return int 1 when a line was read, 0 at the end of the input or on error.
+ */
+static int io_reader_next_pipelined(io_line_reader_t* reader, io_line_t* line)
+{
+    io_pipeline_t* pipeline = reader->pipeline;
+    size_t tail = pipeline->tail; /* only written by this thread */
+
+    reader->end = 0;
+    for (;;)
+    {
+        if (!pipeline->holding)
+        {
+            /* Wait for the producer */
+            pthread_mutex_lock(&pipeline->lock);
+            while (pipeline->head == tail)
+            {
+                pthread_cond_wait(&pipeline->produced, &pipeline->lock);
+            }
+            reader->error = pipeline->error;
+            pthread_mutex_unlock(&pipeline->lock);
+            pipeline->holding = 1;
+            pipeline->position = 0;
+        }
+
+        size_t slot = tail % IO_PIPELINE_CHUNKS;
+        char* chunk = pipeline->chunks[slot];
+        size_t size = pipeline->sizes[slot];
+        if (0 == size)
+        {
+            /* End of the input; keep holding the end marker */
+            reader->eof = 1;
+            if (reader->end > 0 && !reader->error)
+            {
+                reader->buffer[reader->end] = '\0';
+                line->data = reader->buffer;
+                line->length = reader->end;
+                return 1;
+            }
+            return 0;
+        }
+
+        char* start = chunk + pipeline->position;
+        char* newline = memchr(start, '\n', size - pipeline->position);
+        if (newline && 0 == reader->end)
+        {
+            *newline = '\0';
+            line->data = start;
+            line->length = (size_t) (newline - start);
+            pipeline->position = (size_t) (newline - chunk) + 1;
+            return 1;
+        }
+
+        size_t length = newline ? (size_t) (newline - start) : size - pipeline->position;
+        if (EXIT_FAILURE == io_reader_carry(reader, start, length))
+        {
+            reader->error = 1;
+            return 0;
+        }
+        if (newline)
+        {
+            reader->buffer[reader->end] = '\0';
+            line->data = reader->buffer;
+            line->length = reader->end;
+            pipeline->position = (size_t) (newline - chunk) + 1;
+            return 1;
+        }
+
+        /* The chunk is used up: hand it back to the producer */
+        pipeline->holding = 0;
+        pthread_mutex_lock(&pipeline->lock);
+        pipeline->tail = ++tail;
+        pthread_cond_signal(&pipeline->released);
+        pthread_mutex_unlock(&pipeline->lock);
+    }
+}
+
+/**
+ * @brief Opens an input file for line-by-line reading.
+ * A gzip or zstd compressed file is decompressed chunk by chunk.
+ * @param filename The name of the input file (relative to AOC_PUZZLE_INPUT_PATH).
+ * @param reader   The reader to initialise
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
+ */
+uint32_t io_reader_open(const char* filename, io_line_reader_t* reader)
+{
+    char full_path[IO_MAX_PATH_LEN];
+    io_input_path(filename, full_path);
+    clog_info(__FILE__, "Streaming input from file: %s", full_path);
+
+    memset(reader, 0, sizeof(*reader));
+
+    if (EXIT_SUCCESS == io_override_content(&reader->source, &reader->source_size))
+    {
+        reader->fd = -1;
+    }
+    else
+    {
+        reader->fd = open(full_path, O_RDONLY);
+        if (reader->fd < 0)
+        {
+            clog_critical(__FILE__, "Failed to open file: %s", full_path);
+            return (uint32_t) EXIT_FAILURE;
+        }
+        posix_fadvise(reader->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        reader->stream = io_stream_open(reader->fd);
+        if (!reader->stream)
+        {
+            close(reader->fd);
+            reader->fd = -1;
+            return (uint32_t) EXIT_FAILURE;
+        }
+
+        /* Large files and pipes are read by a separate thread while the caller parses */
+        struct stat st;
+        if (0 != fstat(reader->fd, &st) || !S_ISREG(st.st_mode) || (size_t) st.st_size >= IO_PIPELINE_MIN_SIZE)
+        {
+            reader->pipeline = io_pipeline_start(reader->stream);
+        }
+    }
+
+    reader->capacity = IO_READER_BUFFER_SIZE;
+    reader->buffer = (char*) malloc(reader->capacity);
+    if (!reader->buffer)
+    {
+        clog_critical(__FILE__, "Error malloc");
+        io_pipeline_stop(reader->pipeline);
+        io_stream_close(reader->stream);
+        if (reader->fd >= 0)
+        {
+            close(reader->fd);
+        }
+        reader->fd = -1;
+        return (uint32_t) EXIT_FAILURE;
+    }
+
+    return (uint32_t) EXIT_SUCCESS;
+}
+
+/**
+ * @brief Refills the reader's buffer.
+ * The bytes not yet handed out are moved to the front of the buffer and
+ * the rest is filled from the file, or from the selected input stream. The
+ * buffer doubles when it is already completely filled by a single
+ * (partial) line.
+ * @param reader The reader to refill
+ * @return uint32_t EXIT_SUCCESS on success, or EXIT_FAILURE on error.
+ */
+static uint32_t io_reader_fill(io_line_reader_t* reader)
+{
+    if (reader->start > 0)
+    {
+        memmove(reader->buffer, reader->buffer + reader->start, reader->end - reader->start);
+        reader->end -= reader->start;
+        reader->start = 0;
+    }
+
+    /* Always keep one byte free to NUL-terminate the last line */
+    if (reader->end + 1 >= reader->capacity)
+    {
+        char* tmp = realloc(reader->buffer, reader->capacity * 2);
+        if (!tmp)
+        {
+            clog_critical(__FILE__, "Error realloc");
+            return (uint32_t) EXIT_FAILURE;
+        }
+        reader->buffer = tmp;
+        reader->capacity *= 2;
+    }
+
+    ssize_t bytes;
+    if (reader->source)
+    {
+        size_t available = reader->source_size - reader->source_read;
+        size_t room = reader->capacity - reader->end - 1;
+        bytes = (ssize_t) (available < room ? available : room);
+        memcpy(reader->buffer + reader->end, reader->source + reader->source_read, (size_t) bytes);
+        reader->source_read += (size_t) bytes;
+    }
+    else
+    {
+        bytes = io_stream_read(reader->stream, reader->buffer + reader->end, reader->capacity - reader->end - 1);
+    }
+    if (bytes < 0)
+    {
+        clog_critical(__FILE__, "Error while reading");
+        return (uint32_t) EXIT_FAILURE;
+    }
+    if (0 == bytes)
+    {
+        reader->eof = 1;
+    }
+    reader->end += (size_t) bytes;
+    return (uint32_t) EXIT_SUCCESS;
+}
+
+/**
+ * @brief Hands out the next line of the input.
+ * The view points into the reader's buffer and stays valid until the next
+ * call. The newline is replaced by a NUL, so the view is also a C string.
+ * @param reader The reader to read from
+ * @param line   The view to fill
+ * @return int 1 when a line was read, 0 at the end of the input or on error.
+ */
+int io_reader_next(io_line_reader_t* reader, io_line_t* line)
+{
+    if (reader->pipeline)
+    {
+        return io_reader_next_pipelined(reader, line);
+    }
+
+    size_t scanned = reader->start;
+
+    for (;;)
+    {
+        char* newline = memchr(reader->buffer + scanned, '\n', reader->end - scanned);
+        if (newline)
+        {
+            *newline = '\0';
+            line->data = reader->buffer + reader->start;
+            line->length = (size_t) (newline - line->data);
+            reader->start = (size_t) (newline - reader->buffer) + 1;
+            return 1;
+        }
+
+        if (reader->eof || reader->error)
+        {
+            break;
+        }
+
+        /* No complete line buffered yet; only scan the new bytes next time */
+        scanned = reader->end - reader->start;
+        if (EXIT_FAILURE == io_reader_fill(reader))
+        {
+            reader->error = 1;
+            return 0;
+        }
+    }
+
+    /* The last line does not need to end with a newline */
+    if (reader->start < reader->end)
+    {
+        reader->buffer[reader->end] = '\0';
+        line->data = reader->buffer + reader->start;
+        line->length = reader->end - reader->start;
+        reader->start = reader->end;
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Closes a reader opened with io_reader_open().
+ * @param reader The reader to close
+ */
+void io_reader_close(io_line_reader_t* reader)
+{
+    if (NULL == reader)
+    {
+        return;
+    }
+    io_pipeline_stop(reader->pipeline);
+    io_stream_close(reader->stream);
+    if (reader->fd >= 0)
+    {
+        close(reader->fd);
+    }
+    free(reader->buffer);
+    memset(reader, 0, sizeof(*reader));
+    reader->fd = -1;
+}
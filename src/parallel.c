@@ -0,0 +1,109 @@
+/*=====================================================================
+ * @file   parallel.c
+ * @brief  Spread independent tasks over a number of threads.
+ * @details 
+ * This module contains a minimal parallel-for on top of pthreads. Threads
+ * are started per call, which is cheap next to the work the callers hand
+ * out (sorting chunks, solving shards of a puzzle).
+ * 
+ * @author R. Middel
+ * @date   2026-01-20
+ *
+ * @license
+ *      SPDX‑License-Identifier: MIT
+ *
+ *  @notes
+ *    * External dependencies:
+ *     - CLogger: For logging functionality.
+ *     - pthreads: The worker threads.
+ *=====================================================================*/
+#define _GNU_SOURCE /* sysconf() under -std=c11 */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#include "aoc.h"
+#include "parallel.h"
+
+static unsigned parallel_threads = 0;
+
+typedef struct {
+    parallel_task_t body;
+    void* context;
+    size_t tasks;
+    atomic_size_t next; /* next task to hand out */
+} parallel_job_t;
+
+unsigned parallel_thread_count(void)
+{
+    if (parallel_threads > 0)
+    {
+        return parallel_threads;
+    }
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    if (online < 1)
+    {
+        return 1;
+    }
+    return online > PARALLEL_MAX_THREADS ? PARALLEL_MAX_THREADS : (unsigned) online;
+}
+
+void parallel_set_thread_count(unsigned count)
+{
+    parallel_threads = count > PARALLEL_MAX_THREADS ? PARALLEL_MAX_THREADS : count;
+}
+
+/**
+ * @brief Worker: keeps taking tasks until all are handed out.
+ * @param argument The job
+ * @return void* Always NULL
+ */
+static void* parallel_worker(void* argument)
+{
+    parallel_job_t* job = (parallel_job_t*) argument;
+    size_t task;
+
+    while ((task = atomic_fetch_add_explicit(&job->next, 1, memory_order_relaxed)) < job->tasks)
+    {
+        job->body(task, job->context);
+    }
+    return NULL;
+}
+
+void parallel_for(size_t tasks, unsigned threads, parallel_task_t body, void* context)
+{
+    if (0 == threads)
+    {
+        threads = parallel_thread_count();
+    }
+    if (threads > PARALLEL_MAX_THREADS)
+    {
+        threads = PARALLEL_MAX_THREADS;
+    }
+    if (threads > tasks)
+    {
+        threads = (unsigned) tasks;
+    }
+
+    parallel_job_t job = {body, context, tasks, 0};
+    atomic_init(&job.next, 0);
+
+    pthread_t workers[PARALLEL_MAX_THREADS];
+    unsigned started = 0;
+    for (; started + 1 < threads; started++)
+    {
+        if (0 != pthread_create(&workers[started], NULL, parallel_worker, &job))
+        {
+            /* Fewer threads only means less parallelism; the caller still runs every task */
+            clog_error(__FILE__, "Started only %u of %u threads", started + 1, threads);
+            break;
+        }
+    }
+
+    parallel_worker(&job);
+    for (unsigned index = 0; index < started; index++)
+    {
+        pthread_join(workers[index], NULL);
+    }
+}
@@ -0,0 +1,158 @@
+/*=====================================================================
+ * @file   parse.c
+ * @brief  Decimal integer parsers.
+ * @details 
+ * This module contains length-aware parsers for unsigned decimal
+ * integers. Eight digits are validated and converted at once with
+ * SWAR (SIMD within a register) arithmetic on a 64-bit word, which
+ * needs three multiplications instead of eight dependent ones.
+ * 
+ * @author R. Middel
+ * @date   2026-01-20
+ *
+ * @license
+ *      SPDX‑License-Identifier: MIT
+ *
+ *  @notes
+ *    * External dependencies:
+ *     - Standard C Library: For input/output and standard utilities.
+ *=====================================================================*/
+#include <string.h>
+
+#include "parse.h"
+
+#define SWAR_ZEROS 0x3030303030303030ULL
+#define SWAR_HIGH_NIBBLES 0xF0F0F0F0F0F0F0F0ULL
+#define SWAR_SIX 0x0606060606060606ULL
+
+/* Scale of a group of n digits */
+static const uint32_t parse_pow10[9] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+
+/**
+ * @brief Load 8 characters so that the first character is the lowest byte.
+ */
+static inline uint64_t swar_load(const char* src)
+{
+    uint64_t chunk;
+    memcpy(&chunk, src, sizeof(chunk));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    chunk = __builtin_bswap64(chunk);
+#endif
+    return chunk;
+}
+
+/**
+ * @brief Count the leading digits (0-8) of a loaded chunk.
+ * A byte is a digit when its high nibble is 3 and adding 6 does not
+ * carry out of the low nibble.
+ */
+static inline size_t swar_digit_count(uint64_t chunk)
+{
+    uint64_t non_digits = ((chunk & SWAR_HIGH_NIBBLES) ^ SWAR_ZEROS) | (((chunk + SWAR_SIX) & SWAR_HIGH_NIBBLES) ^ SWAR_ZEROS);
+    return non_digits ? (size_t) __builtin_ctzll(non_digits) / 8 : 8;
+}
+
+/**
+ * @brief Convert a chunk of exactly 8 ASCII digits into its value.
+ */
+static inline uint32_t swar_convert(uint64_t chunk)
+{
+    chunk -= SWAR_ZEROS;
+    chunk = (chunk * 10) + (chunk >> 8);                               /* pairs of digits */
+    chunk = (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+             (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32; /* 8 digits */
+    return (uint32_t) chunk;
+}
+
+/**
+ * @brief Convert the first count (1-7) digits of a chunk.
+ * The digits are shifted to the end of the word and the front is padded
+ * with '0' characters, so the 8-digit conversion can be reused.
+ */
+static inline uint32_t swar_convert_partial(uint64_t chunk, size_t count)
+{
+    return swar_convert((chunk << (8 * (8 - count))) | (SWAR_ZEROS >> (8 * count)));
+}
+
+/**
+ * @brief Parse the next group of up to 8 digits.
+ * @param src       Characters to parse
+ * @param remaining Number of characters available in src
+ * @param group     The value of the digits in the group
+ * @return size_t Number of digits in the group; less than 8 ends the number
+ */
+static inline size_t parse_group(const char* src, size_t remaining, uint32_t* group)
+{
+    if (remaining >= 8)
+    {
+        uint64_t chunk = swar_load(src);
+        size_t digits = swar_digit_count(chunk);
+        *group = (8 == digits) ? swar_convert(chunk) : (digits > 0) ? swar_convert_partial(chunk, digits) : 0;
+        return digits;
+    }
+
+    uint32_t value = 0;
+    size_t digits = 0;
+    for (; digits < remaining && (unsigned) (src[digits] - '0') < 10; digits++)
+    {
+        value = (value * 10) + (uint32_t) (src[digits] - '0');
+    }
+    *group = value;
+    return digits;
+}
+
+size_t parse_u32(const char* src, size_t length, uint32_t* value)
+{
+    uint64_t wide;
+    size_t consumed = parse_u64(src, length, &wide);
+    if (wide > UINT32_MAX)
+    {
+        *value = 0;
+        return 0;
+    }
+    *value = (uint32_t) wide;
+    return consumed;
+}
+
+size_t parse_u64(const char* src, size_t length, uint64_t* value)
+{
+    uint64_t result = 0;
+    size_t index = 0;
+    size_t digits;
+    uint32_t group;
+
+    do
+    {
+        digits = parse_group(src + index, length - index, &group);
+        /* Widened, so a number beyond UINT64_MAX is caught instead of wrapping */
+        __uint128_t next = ((__uint128_t) result * parse_pow10[digits]) + group;
+        if (next > UINT64_MAX)
+        {
+            *value = 0;
+            return 0;
+        }
+        result = (uint64_t) next;
+        index += digits;
+    } while (8 == digits);
+
+    *value = result;
+    return index;
+}
+
+size_t parse_u128(const char* src, size_t length, __uint128_t* value)
+{
+    __uint128_t result = 0;
+    size_t index = 0;
+    size_t digits;
+    uint32_t group;
+
+    do
+    {
+        digits = parse_group(src + index, length - index, &group);
+        result = (result * parse_pow10[digits]) + group;
+        index += digits;
+    } while (8 == digits);
+
+    *value = result;
+    return index;
+}
@@ -15,70 +15,517 @@
  *     - CLogger: For logging functionality.
  *     - Standard C Library: For input/output and standard utilities.
  *=====================================================================*/
+#include <stdlib.h>
 #include <string.h>
 
+#include "parallel.h"
 #include "sort.h"
 
-uint64_t* quick_sort_uint64(uint64_t* array, size_t len)
+/**
+ * @brief Extract the digit of a key that a radix pass sorts on.
+ */
+static inline size_t radix_digit(uint64_t key, size_t pass)
+{
+    return (size_t) (key >> (pass * SORT_RADIX_BITS)) & (SORT_RADIX_BUCKETS - 1);
+}
+
+/**
+ * @brief Build the histograms of all radix passes in one read of the keys.
+ * @param keys   first key
+ * @param len    number of keys
+ * @param stride distance between two keys in uint64_t words
+ * @param counts histogram per pass, turned into the start offset per bucket
+ * @param skip   set per pass when all keys share the digit of that pass
+ * @return int non-zero when the keys are already in ascending order
+ */
+static int radix_histogram(const uint64_t* keys, size_t len, size_t stride,
+                           size_t counts[SORT_RADIX_PASSES][SORT_RADIX_BUCKETS], int skip[SORT_RADIX_PASSES])
 {
-    if (len < 2)
+    int sorted = 1;
+    memset(counts, 0, sizeof(size_t) * SORT_RADIX_PASSES * SORT_RADIX_BUCKETS);
+
+    uint64_t previous = keys[0];
+    for (size_t index = 0; index < len; index++)
     {
-        return array;
+        uint64_t key = keys[index * stride];
+        sorted &= previous <= key;
+        previous = key;
+        for (size_t pass = 0; pass < SORT_RADIX_PASSES; pass++)
+        {
+            counts[pass][radix_digit(key, pass)]++;
+        }
     }
-    for (size_t i = 0; i < len - 1; i++)
+
+    for (size_t pass = 0; pass < SORT_RADIX_PASSES; pass++)
     {
-        for (size_t j = 0; j < len - i - 1; j++)
+        skip[pass] = (len == counts[pass][radix_digit(keys[0], pass)]);
+
+        size_t offset = 0;
+        for (size_t bucket = 0; bucket < SORT_RADIX_BUCKETS; bucket++)
         {
-            if (array[j] > array[j + 1])
-            {
-                uint64_t temp = array[j];
-                array[j] = array[j + 1];
-                array[j + 1] = temp;
-            }
+            size_t count = counts[pass][bucket];
+            counts[pass][bucket] = offset;
+            offset += count;
         }
     }
-    return array;
+    return sorted;
 }
 
-char* quick_sort(char* array)
+void radix_sort_uint64(uint64_t* array, size_t len, uint64_t* scratch)
 {
-    size_t len = strlen(array);
-    if (len < 2)
+    if (len < SORT_INSERTION_LIMIT)
     {
-        return array;
+        introsort_uint64_insertion(array, len);
+        return;
     }
-    for (size_t i = 0; i < len - 1; i++)
+
+    size_t counts[SORT_RADIX_PASSES][SORT_RADIX_BUCKETS];
+    int skip[SORT_RADIX_PASSES];
+    if (radix_histogram(array, len, 1, counts, skip))
+    {
+        return;
+    }
+
+    uint64_t* source = array;
+    uint64_t* target = scratch;
+    for (size_t pass = 0; pass < SORT_RADIX_PASSES; pass++)
     {
-        for (size_t j = 0; j < len - i - 1; j++)
+        if (skip[pass])
+        {
+            continue;
+        }
+        size_t* offsets = counts[pass];
+        for (size_t index = 0; index < len; index++)
         {
-            if (array[j] > array[j + 1])
-            {
-                char temp = array[j];
-                array[j] = array[j + 1];
-                array[j + 1] = temp;
-            }
+            uint64_t key = source[index];
+            target[offsets[radix_digit(key, pass)]++] = key;
         }
+        uint64_t* swap = source;
+        source = target;
+        target = swap;
+    }
+
+    if (source != array)
+    {
+        memcpy(array, source, len * sizeof(uint64_t));
     }
-    return array;
 }
-char* quick_sort_rev(char* array)
+
+void radix_sort_range(range_t* array, size_t len, range_t* scratch)
 {
-    size_t len = strlen(array);
-    if (len < 2)
+    if (len < SORT_INSERTION_LIMIT)
     {
-        return array;
+        /* The insertion sort is stable, like the radix passes */
+        introsort_range_insertion(array, len);
+        return;
+    }
+
+    size_t counts[SORT_RADIX_PASSES][SORT_RADIX_BUCKETS];
+    int skip[SORT_RADIX_PASSES];
+    if (radix_histogram(&array[0].start, len, sizeof(range_t) / sizeof(uint64_t), counts, skip))
+    {
+        return;
     }
-    for (size_t i = 0; i < len - 1; i++)
+
+    range_t* source = array;
+    range_t* target = scratch;
+    for (size_t pass = 0; pass < SORT_RADIX_PASSES; pass++)
     {
-        for (size_t j = 0; j < len - i - 1; j++)
+        if (skip[pass])
+        {
+            continue;
+        }
+        size_t* offsets = counts[pass];
+        for (size_t index = 0; index < len; index++)
         {
-            if (array[j] < array[j + 1])
-            {
-                char temp = array[j];
-                array[j] = array[j + 1];
-                array[j + 1] = temp;
-            }
+            target[offsets[radix_digit(source[index].start, pass)]++] = source[index];
         }
+        range_t* swap = source;
+        source = target;
+        target = swap;
+    }
+
+    if (source != array)
+    {
+        memcpy(array, source, len * sizeof(range_t));
+    }
+}
+
+/**
+ * @brief State shared by the tasks of a parallel sort.
+ * Elements are `words` uint64_t long with the key in the first word, so
+ * uint64_t (1 word) and range_t (2 words) share the implementation.
+ */
+typedef struct {
+    uint64_t* array;
+    uint64_t* scratch;
+    size_t len;
+    size_t words;
+    size_t runs;                                 /* number of chunks (= threads) */
+    size_t bounds[PARALLEL_MAX_THREADS + 1];     /* chunk i holds elements [bounds[i], bounds[i + 1]) */
+    size_t splits[PARALLEL_MAX_THREADS + 1][PARALLEL_MAX_THREADS]; /* first element of run i in output part p */
+} parallel_sort_t;
+
+static inline uint64_t parallel_key(const parallel_sort_t* sort, size_t element)
+{
+    return sort->array[element * sort->words];
+}
+
+/**
+ * @brief Task: radix sort one chunk.
+ */
+static void parallel_sort_chunk(size_t task, void* context)
+{
+    parallel_sort_t* sort = (parallel_sort_t*) context;
+    size_t first = sort->bounds[task];
+    size_t count = sort->bounds[task + 1] - first;
+
+    if (1 == sort->words)
+    {
+        radix_sort_uint64(sort->array + first, count, sort->scratch + first);
+    }
+    else
+    {
+        radix_sort_range((range_t*) sort->array + first, count, (range_t*) sort->scratch + first);
+    }
+}
+
+/**
+ * @brief First element in [first, last) of a sorted run whose key is greater than
+ *        (or, with inclusive set, at least) a value.
+ */
+static size_t parallel_bound(const parallel_sort_t* sort, size_t first, size_t last, uint64_t value, int inclusive)
+{
+    while (first < last)
+    {
+        size_t middle = first + (last - first) / 2;
+        uint64_t key = parallel_key(sort, middle);
+        if (inclusive ? key < value : key <= value)
+        {
+            first = middle + 1;
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+    return first;
+}
+
+/**
+ * @brief Find where every run splits so exactly `rank` elements go in front.
+ * The split key is the smallest value with at least `rank` elements at or
+ * below it. Elements equal to it are taken from the earlier runs first,
+ * which keeps the merge stable.
+ */
+static void parallel_select(parallel_sort_t* sort, size_t rank, size_t* splits)
+{
+    uint64_t low = 0, high = UINT64_MAX;
+    while (low < high)
+    {
+        uint64_t middle = low + (high - low) / 2;
+        size_t count = 0;
+        for (size_t run = 0; run < sort->runs; run++)
+        {
+            count += parallel_bound(sort, sort->bounds[run], sort->bounds[run + 1], middle, 0) - sort->bounds[run];
+        }
+        if (count >= rank)
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle + 1;
+        }
+    }
+
+    size_t below = 0;
+    for (size_t run = 0; run < sort->runs; run++)
+    {
+        splits[run] = parallel_bound(sort, sort->bounds[run], sort->bounds[run + 1], low, 1);
+        below += splits[run] - sort->bounds[run];
+    }
+    for (size_t run = 0; run < sort->runs && below < rank; run++)
+    {
+        size_t equal = parallel_bound(sort, splits[run], sort->bounds[run + 1], low, 0) - splits[run];
+        size_t take = equal < rank - below ? equal : rank - below;
+        splits[run] += take;
+        below += take;
+    }
+}
+
+/**
+ * @brief Heap order of two runs: smaller key first, the earlier run on ties.
+ */
+static inline int parallel_before(const parallel_sort_t* sort, const size_t* heads, size_t left, size_t right)
+{
+    uint64_t left_key = parallel_key(sort, heads[left]);
+    uint64_t right_key = parallel_key(sort, heads[right]);
+    return left_key < right_key || (left_key == right_key && left < right);
+}
+
+/**
+ * @brief Restore the heap below position `index`.
+ */
+static void parallel_sift_down(const parallel_sort_t* sort, const size_t* heads, size_t* heap, size_t size, size_t index)
+{
+    for (;;)
+    {
+        size_t smallest = index;
+        size_t left = 2 * index + 1;
+        size_t right = left + 1;
+        if (left < size && parallel_before(sort, heads, heap[left], heap[smallest]))
+        {
+            smallest = left;
+        }
+        if (right < size && parallel_before(sort, heads, heap[right], heap[smallest]))
+        {
+            smallest = right;
+        }
+        if (smallest == index)
+        {
+            return;
+        }
+        size_t swap = heap[index];
+        heap[index] = heap[smallest];
+        heap[smallest] = swap;
+        index = smallest;
+    }
+}
+
+/**
+ * @brief Task: merge the slices of all runs that form one output part into scratch.
+ */
+static void parallel_merge_part(size_t task, void* context)
+{
+    parallel_sort_t* sort = (parallel_sort_t*) context;
+    size_t heads[PARALLEL_MAX_THREADS];
+    size_t heap[PARALLEL_MAX_THREADS];
+    size_t size = 0;
+    const size_t* ends = sort->splits[task + 1];
+
+    size_t out = 0;
+    for (size_t run = 0; run < sort->runs; run++)
+    {
+        heads[run] = sort->splits[task][run];
+        out += heads[run] - sort->bounds[run];
+        if (heads[run] < ends[run])
+        {
+            heap[size++] = run;
+        }
+    }
+    for (size_t index = size; index-- > 0;)
+    {
+        parallel_sift_down(sort, heads, heap, size, index);
+    }
+
+    uint64_t* target = sort->scratch + out * sort->words;
+    while (size > 0)
+    {
+        size_t run = heap[0];
+        const uint64_t* source = sort->array + heads[run] * sort->words;
+        for (size_t word = 0; word < sort->words; word++)
+        {
+            *target++ = source[word];
+        }
+
+        if (++heads[run] == ends[run])
+        {
+            heap[0] = heap[--size];
+        }
+        parallel_sift_down(sort, heads, heap, size, 0);
+    }
+}
+
+/**
+ * @brief Task: copy one merged output part back into the array.
+ */
+static void parallel_copy_part(size_t task, void* context)
+{
+    parallel_sort_t* sort = (parallel_sort_t*) context;
+    size_t first = task * sort->len / sort->runs;
+    size_t last = (task + 1) * sort->len / sort->runs;
+    memcpy(sort->array + first * sort->words, sort->scratch + first * sort->words,
+           (last - first) * sort->words * sizeof(uint64_t));
+}
+
+/**
+ * @brief Sort chunks on every thread, then merge them in parallel.
+ */
+static void parallel_sort(uint64_t* array, size_t len, uint64_t* scratch, size_t words, unsigned threads)
+{
+    parallel_sort_t* sort = (parallel_sort_t*) malloc(sizeof(parallel_sort_t));
+    if (!sort)
+    {
+        /* Not enough memory for the bookkeeping: sort on this thread */
+        threads = 1;
+    }
+    if (1 == threads)
+    {
+        free(sort);
+        if (1 == words)
+        {
+            radix_sort_uint64(array, len, scratch);
+        }
+        else
+        {
+            radix_sort_range((range_t*) array, len, (range_t*) scratch);
+        }
+        return;
+    }
+
+    sort->array = array;
+    sort->scratch = scratch;
+    sort->len = len;
+    sort->words = words;
+    sort->runs = threads;
+    for (size_t run = 0; run <= sort->runs; run++)
+    {
+        sort->bounds[run] = run * len / sort->runs;
+    }
+
+    parallel_for(sort->runs, threads, parallel_sort_chunk, sort);
+
+    /* Output part p covers ranks [p * len / runs, (p + 1) * len / runs) */
+    for (size_t run = 0; run < sort->runs; run++)
+    {
+        sort->splits[0][run] = sort->bounds[run];
+        sort->splits[sort->runs][run] = sort->bounds[run + 1];
+    }
+    for (size_t part = 1; part < sort->runs; part++)
+    {
+        parallel_select(sort, part * len / sort->runs, sort->splits[part]);
+    }
+
+    parallel_for(sort->runs, threads, parallel_merge_part, sort);
+    parallel_for(sort->runs, threads, parallel_copy_part, sort);
+    free(sort);
+}
+
+/**
+ * @brief Pick the number of threads for a parallel sort of len elements.
+ */
+static unsigned parallel_sort_threads(size_t len, unsigned threads)
+{
+    if (0 == threads)
+    {
+        threads = parallel_thread_count();
+    }
+    if (threads > PARALLEL_MAX_THREADS)
+    {
+        threads = PARALLEL_MAX_THREADS;
+    }
+    /* Every thread should get a chunk worth the overhead */
+    if (len / SORT_PARALLEL_MIN < threads)
+    {
+        threads = (unsigned) (len / SORT_PARALLEL_MIN);
+    }
+    return threads > 0 ? threads : 1;
+}
+
+void parallel_sort_uint64(uint64_t* array, size_t len, uint64_t* scratch, unsigned threads)
+{
+    parallel_sort(array, len, scratch, 1, parallel_sort_threads(len, threads));
+}
+
+void parallel_sort_range(range_t* array, size_t len, range_t* scratch, unsigned threads)
+{
+    parallel_sort((uint64_t*) array, len, (uint64_t*) scratch, sizeof(range_t) / sizeof(uint64_t),
+                  parallel_sort_threads(len, threads));
+}
+
+uint64_t* quick_sort_uint64(uint64_t* array, size_t len)
+{
+    if (len < SORT_INSERTION_LIMIT)
+    {
+        radix_sort_uint64(array, len, NULL);
+        return array;
+    }
+
+    uint64_t* scratch = (uint64_t*) malloc(len * sizeof(uint64_t));
+    if (!scratch)
+    {
+        /* Out of memory for the scratch buffer: sort in place instead */
+        introsort_uint64(array, len);
+        return array;
+    }
+    radix_sort_uint64(array, len, scratch);
+    free(scratch);
+    return array;
+}
+
+void char_histogram(const char* array, size_t len, size_t histogram[SORT_ALPHABET_SIZE])
+{
+    /* Four interleaved tables, so runs of equal characters do not serialise on one counter */
+    size_t partial[4][SORT_ALPHABET_SIZE];
+    const unsigned char* bytes = (const unsigned char*) array;
+    size_t index = 0;
+
+    memset(partial, 0, sizeof(partial));
+    for (; index + 4 <= len; index += 4)
+    {
+        partial[0][bytes[index]]++;
+        partial[1][bytes[index + 1]]++;
+        partial[2][bytes[index + 2]]++;
+        partial[3][bytes[index + 3]]++;
+    }
+    for (; index < len; index++)
+    {
+        partial[0][bytes[index]]++;
+    }
+
+    for (size_t symbol = 0; symbol < SORT_ALPHABET_SIZE; symbol++)
+    {
+        histogram[symbol] = partial[0][symbol] + partial[1][symbol] + partial[2][symbol] + partial[3][symbol];
+    }
+}
+
+char* counting_sort_char(char* array, size_t len)
+{
+    size_t histogram[SORT_ALPHABET_SIZE];
+    char_histogram(array, len, histogram);
+
+    char* out = array;
+    for (size_t symbol = 0; symbol < SORT_ALPHABET_SIZE; symbol++)
+    {
+        memset(out, (int) symbol, histogram[symbol]);
+        out += histogram[symbol];
+    }
+    return array;
+}
+
+char* counting_sort_char_rev(char* array, size_t len)
+{
+    size_t histogram[SORT_ALPHABET_SIZE];
+    char_histogram(array, len, histogram);
+
+    char* out = array;
+    for (size_t symbol = SORT_ALPHABET_SIZE; symbol-- > 0;)
+    {
+        memset(out, (int) symbol, histogram[symbol]);
+        out += histogram[symbol];
     }
     return array;
-}
\ No newline at end of file
+}
+
+size_t histogram_largest(const size_t histogram[SORT_ALPHABET_SIZE], size_t k, char* out)
+{
+    size_t written = 0;
+    for (size_t symbol = SORT_ALPHABET_SIZE; symbol-- > 0 && written < k;)
+    {
+        size_t count = histogram[symbol] < k - written ? histogram[symbol] : k - written;
+        memset(out + written, (int) symbol, count);
+        written += count;
+    }
+    return written;
+}
+
+char* quick_sort(char* array)
+{
+    return counting_sort_char(array, strlen(array));
+}
+
+char* quick_sort_rev(char* array)
+{
+    return counting_sort_char_rev(array, strlen(array));
+}
@@ -8,12 +8,23 @@
  * @version 1.0
  * @copyright Copyright (c) 2025 R. Middel
  */
+#define _GNU_SOURCE /* pipe() under -std=c11 */
+
+#include <inttypes.h>
+#include <string.h>
+#include <unistd.h>
 
 #include <aoc.h>
+#include <conversion.h>
+#include <interval.h>
+#include <io.h>
+#include <parallel.h>
+#include <parse.h>
+#include <sort.h>
 #include <unity.h>
 
-void test_day01_part1(void) { TEST_ASSERT_EQUAL_INT32(3, day01_part1()); }
-void test_day01_part2(void) { TEST_ASSERT_EQUAL_INT32(6, day01_part2()); }
+void test_day01_part1(void) { TEST_ASSERT_EQUAL_UINT64(3, day01_part1()); }
+void test_day01_part2(void) { TEST_ASSERT_EQUAL_UINT64(6, day01_part2()); }
 
 void test_day02_part1(void) { TEST_ASSERT_EQUAL_INT64(1227775554, day02_part1()); }
 void test_day02_part2(void) { TEST_ASSERT_EQUAL_INT64(4174379265, day02_part2()); }
@@ -33,21 +44,582 @@ void test_day06_part2(void) { TEST_ASSERT_EQUAL_INT64(3263827, day06_part2()); }
 void test_day07_part1(void) { TEST_ASSERT_EQUAL_INT32(21, day07_part1()); }
 void test_day07_part2(void) { TEST_ASSERT_EQUAL_INT32(40, day07_part2()); }
 
+void test_parse_u32(void)
+{
+    uint32_t value = 0;
+    TEST_ASSERT_EQUAL_size_t(2, parse_u32("68\n", 3, &value));
+    TEST_ASSERT_EQUAL_UINT32(68, value);
+    TEST_ASSERT_EQUAL_size_t(0, parse_u32("L68", 3, &value));
+    TEST_ASSERT_EQUAL_UINT32(0, value);
+    TEST_ASSERT_EQUAL_size_t(10, parse_u32("4294967295", 10, &value));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, value);
+    TEST_ASSERT_EQUAL_size_t(0, parse_u32("4294967296", 10, &value));
+    TEST_ASSERT_EQUAL_UINT32(0, value);
+}
+void test_parse_u64(void)
+{
+    uint64_t value = 0;
+    TEST_ASSERT_EQUAL_size_t(10, parse_u64("1188511880-1188511890", 21, &value));
+    TEST_ASSERT_EQUAL_UINT64(1188511880ULL, value);
+    TEST_ASSERT_EQUAL_size_t(20, parse_u64("18446744073709551615", 20, &value));
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, value);
+    TEST_ASSERT_EQUAL_size_t(0, parse_u64("18446744073709551616", 20, &value));
+    TEST_ASSERT_EQUAL_UINT64(0, value);
+    TEST_ASSERT_EQUAL_size_t(0, parse_u64("100000000000000000000", 21, &value));
+    TEST_ASSERT_EQUAL_size_t(4, parse_u64("123456", 4, &value));
+    TEST_ASSERT_EQUAL_UINT64(1234, value);
+}
+void test_parse_u128(void)
+{
+    __uint128_t value = 0;
+    TEST_ASSERT_EQUAL_size_t(25, parse_u128("1234567890123456789012345", 25, &value));
+    TEST_ASSERT_TRUE(value == (__uint128_t) 1234567890123456789ULL * 1000000 + 12345);
+}
+
+void test_tokenizer_delimiter(void)
+{
+    tokenizer_t tokenizer;
+    const char* token;
+    size_t length;
+    tokenizer_init(&tokenizer, "11-22,,95-115", 13, ',');
+    TEST_ASSERT_TRUE(tokenizer_next(&tokenizer, &token, &length));
+    TEST_ASSERT_EQUAL_STRING_LEN("11-22", token, 5);
+    TEST_ASSERT_EQUAL_size_t(5, length);
+    TEST_ASSERT_TRUE(tokenizer_next(&tokenizer, &token, &length));
+    TEST_ASSERT_EQUAL_size_t(0, length);
+    TEST_ASSERT_TRUE(tokenizer_next(&tokenizer, &token, &length));
+    TEST_ASSERT_EQUAL_STRING_LEN("95-115", token, 6);
+    TEST_ASSERT_FALSE(tokenizer_next(&tokenizer, &token, &length));
+}
+void test_tokenizer_whitespace(void)
+{
+    tokenizer_t tokenizer;
+    const char* token;
+    size_t length;
+    tokenizer_init(&tokenizer, "  6 98  215 314\n", 16, TOKENIZER_WHITESPACE);
+    TEST_ASSERT_TRUE(tokenizer_next(&tokenizer, &token, &length));
+    TEST_ASSERT_EQUAL_STRING_LEN("6", token, 1);
+    TEST_ASSERT_TRUE(tokenizer_next(&tokenizer, &token, &length));
+    TEST_ASSERT_TRUE(tokenizer_next(&tokenizer, &token, &length));
+    TEST_ASSERT_TRUE(tokenizer_next(&tokenizer, &token, &length));
+    TEST_ASSERT_EQUAL_STRING_LEN("314", token, 3);
+    TEST_ASSERT_EQUAL_size_t(3, length);
+    TEST_ASSERT_FALSE(tokenizer_next(&tokenizer, &token, &length));
+}
+
+void test_u64_format(void)
+{
+    char buffer[U64_MAX_DIGITS + 1];
+    char expected[U64_MAX_DIGITS + 1];
+
+    /* Every power of 10 and its neighbours, where the digit count changes */
+    for (unsigned exponent = 0; exponent < U64_MAX_DIGITS; exponent++)
+    {
+        uint64_t power = u64_pow10(exponent);
+        for (uint64_t value = power - 1; value <= power + 1; value++)
+        {
+            int length = snprintf(expected, sizeof(expected), "%" PRIu64, value);
+            TEST_ASSERT_EQUAL_UINT((unsigned) length, u64_digit_count(value));
+            TEST_ASSERT_EQUAL_size_t((size_t) length, u64_to_str(value, buffer));
+            TEST_ASSERT_EQUAL_STRING(expected, buffer);
+        }
+    }
+    TEST_ASSERT_EQUAL_size_t(20, u64_to_str(UINT64_MAX, buffer));
+    TEST_ASSERT_EQUAL_STRING("18446744073709551615", buffer);
+
+    long_to_str(-1234, buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL_STRING("-1234", buffer);
+    long_to_str(123456, buffer, 4);
+    TEST_ASSERT_EQUAL_STRING("123", buffer);
+}
+
+void test_radix_sort_uint64(void)
+{
+    uint64_t array[1000];
+    uint64_t scratch[1000];
+    uint64_t small[5] = {5, 3, UINT64_MAX, 0, 3};
+    uint64_t small_sorted[5] = {0, 3, 3, 5, UINT64_MAX};
+
+    /* Keys that differ in every digit, including the top bits */
+    for (size_t index = 0; index < 1000; index++)
+    {
+        array[index] = (uint64_t) (index * 7919 % 1000) * 0x9E3779B97F4A7C15ULL;
+    }
+    radix_sort_uint64(array, 1000, scratch);
+    for (size_t index = 1; index < 1000; index++)
+    {
+        TEST_ASSERT_TRUE(array[index - 1] <= array[index]);
+    }
+
+    radix_sort_uint64(small, 5, scratch);
+    TEST_ASSERT_EQUAL_UINT64_ARRAY(small_sorted, small, 5);
+    TEST_ASSERT_EQUAL_UINT64(0, quick_sort_uint64(array, 1000)[0]);
+}
+
+void test_radix_sort_range(void)
+{
+    range_t ranges[200];
+    range_t scratch[200];
+
+    /* Equal starts keep their order: the sort is stable */
+    for (size_t index = 0; index < 200; index++)
+    {
+        ranges[index].start = (uint64_t) (199 - index) / 2 + 1000000000000ULL;
+        ranges[index].end_including = index;
+    }
+    radix_sort_range(ranges, 200, scratch);
+    for (size_t index = 1; index < 200; index++)
+    {
+        TEST_ASSERT_TRUE(ranges[index - 1].start <= ranges[index].start);
+        if (ranges[index - 1].start == ranges[index].start)
+        {
+            TEST_ASSERT_TRUE(ranges[index - 1].end_including < ranges[index].end_including);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT64(1000000000000ULL, ranges[0].start);
+    TEST_ASSERT_EQUAL_UINT64(198, ranges[0].end_including);
+}
+
+void test_introsort(void)
+{
+    uint64_t keys[1000];
+    key_index_t pairs[1000];
+    int seen[1000] = {0};
+
+    /* Few distinct keys in a sawtooth: the pairs must stay a permutation */
+    for (size_t index = 0; index < 1000; index++)
+    {
+        keys[index] = (index * 7) % 13;
+        pairs[index].key = keys[index];
+        pairs[index].index = index;
+    }
+    introsort_key_index(pairs, 1000);
+    for (size_t index = 0; index < 1000; index++)
+    {
+        TEST_ASSERT_TRUE(index == 0 || pairs[index - 1].key <= pairs[index].key);
+        TEST_ASSERT_EQUAL_UINT64(keys[pairs[index].index], pairs[index].key);
+        seen[pairs[index].index]++;
+    }
+    for (size_t index = 0; index < 1000; index++)
+    {
+        TEST_ASSERT_EQUAL_INT(1, seen[index]);
+    }
+
+    /* Reversed input, the classic quicksort worst case without a median */
+    for (size_t index = 0; index < 1000; index++)
+    {
+        keys[index] = 1000 - index;
+    }
+    introsort_uint64(keys, 1000);
+    for (size_t index = 0; index < 1000; index++)
+    {
+        TEST_ASSERT_EQUAL_UINT64(index + 1, keys[index]);
+    }
+}
+
+void test_parallel_sort(void)
+{
+    size_t count = 4 * SORT_PARALLEL_MIN + 123;
+    uint64_t* array = malloc(count * sizeof(uint64_t));
+    uint64_t* scratch = malloc(count * sizeof(uint64_t));
+    range_t* ranges = malloc(count * sizeof(range_t));
+    range_t* range_scratch = malloc(count * sizeof(range_t));
+    TEST_ASSERT_NOT_NULL(array);
+    TEST_ASSERT_NOT_NULL(scratch);
+    TEST_ASSERT_NOT_NULL(ranges);
+    TEST_ASSERT_NOT_NULL(range_scratch);
+
+    /* Few distinct keys, so the part boundaries cut through runs of equal keys */
+    uint64_t sum = 0;
+    for (size_t index = 0; index < count; index++)
+    {
+        array[index] = (uint64_t) (index * 2654435761u % 1000) << 40;
+        ranges[index].start = array[index];
+        ranges[index].end_including = index;
+        sum += array[index];
+    }
+
+    parallel_sort_uint64(array, count, scratch, 4);
+    parallel_sort_range(ranges, count, range_scratch, 4);
+    for (size_t index = 1; index < count; index++)
+    {
+        TEST_ASSERT_TRUE(array[index - 1] <= array[index]);
+        TEST_ASSERT_TRUE(ranges[index - 1].start < ranges[index].start ||
+                         (ranges[index - 1].start == ranges[index].start &&
+                          ranges[index - 1].end_including < ranges[index].end_including));
+        sum -= array[index];
+    }
+    TEST_ASSERT_EQUAL_UINT64(array[0], sum);
+
+    free(range_scratch);
+    free(ranges);
+    free(scratch);
+    free(array);
+}
+
+void test_counting_sort(void)
+{
+    char digits[] = "987654321111111";
+    char mixed[] = "b\xff" "a0";
+    char largest[4] = {0};
+    size_t histogram[SORT_ALPHABET_SIZE];
+
+    TEST_ASSERT_EQUAL_STRING("111111123456789", counting_sort_char(digits, strlen(digits)));
+    TEST_ASSERT_EQUAL_STRING("987654321111111", counting_sort_char_rev(digits, strlen(digits)));
+    TEST_ASSERT_EQUAL_STRING("0ab\xff", quick_sort(mixed));
+    TEST_ASSERT_EQUAL_STRING("\xff" "ba0", quick_sort_rev(mixed));
+
+    char_histogram("818181911", 9, histogram);
+    TEST_ASSERT_EQUAL_size_t(3, histogram['8']);
+    TEST_ASSERT_EQUAL_size_t(3, histogram_largest(histogram, 3, largest));
+    TEST_ASSERT_EQUAL_STRING("988", largest);
+    TEST_ASSERT_EQUAL_size_t(0, histogram_largest(histogram, 0, largest));
+}
+
+void test_interval_set(void)
+{
+    /* Unordered, overlapping, adjacent, empty (8-7) and reaching UINT64_MAX */
+    const range_t ranges[] = {{20, 30}, {1, 5}, {6, 9}, {8, 7}, {25, 40}, {UINT64_MAX - 1, UINT64_MAX}, {3, 4}};
+    const range_t others[] = {{10, 12}, {50, 60}};
+    interval_set_t set, other, joined, clipped;
+
+    TEST_ASSERT_EQUAL_UINT32(EXIT_SUCCESS, interval_set_build(&set, ranges, 7));
+    TEST_ASSERT_EQUAL_size_t(3, set.count);
+    TEST_ASSERT_EQUAL_UINT64(1, set.ranges[0].start);
+    TEST_ASSERT_EQUAL_UINT64(9, set.ranges[0].end_including);
+    TEST_ASSERT_EQUAL_UINT64(40, set.ranges[1].end_including);
+    TEST_ASSERT_EQUAL_UINT64(9 + 21 + 2, (uint64_t) interval_set_length(&set));
+    TEST_ASSERT_TRUE(interval_set_contains(&set, 6));
+    TEST_ASSERT_TRUE(interval_set_contains(&set, UINT64_MAX));
+    TEST_ASSERT_FALSE(interval_set_contains(&set, 0));
+    TEST_ASSERT_FALSE(interval_set_contains(&set, 15));
+
+    /* {10, 12} touches {1, 9}, so the union merges them */
+    TEST_ASSERT_EQUAL_UINT32(EXIT_SUCCESS, interval_set_build(&other, others, 2));
+    TEST_ASSERT_EQUAL_UINT32(EXIT_SUCCESS, interval_set_union(&joined, &set, &other));
+    TEST_ASSERT_EQUAL_size_t(4, joined.count);
+    TEST_ASSERT_EQUAL_UINT64(12, joined.ranges[0].end_including);
+
+    TEST_ASSERT_EQUAL_UINT32(EXIT_SUCCESS, interval_set_clip(&clipped, &joined, 11, 55));
+    TEST_ASSERT_EQUAL_size_t(3, clipped.count);
+    TEST_ASSERT_EQUAL_UINT64(11, clipped.ranges[0].start);
+    TEST_ASSERT_EQUAL_UINT64(55, clipped.ranges[2].end_including);
+
+    interval_set_free(&clipped);
+    interval_set_free(&joined);
+    interval_set_free(&other);
+    interval_set_free(&set);
+}
+
+/**
+ * @brief Select content as the input through a pipe, like a stream on stdin.
+ * The content must fit the pipe buffer (64 KiB on Linux).
+ */
+static void set_input_bytes(const void* content, size_t size)
+{
+    char pipe_path[32];
+    int fds[2];
+
+    TEST_ASSERT_EQUAL_INT(0, pipe(fds));
+    TEST_ASSERT_EQUAL_INT64(size, write(fds[1], content, size));
+    close(fds[1]);
+    snprintf(pipe_path, sizeof(pipe_path), "/dev/fd/%d", fds[0]);
+    TEST_ASSERT_EQUAL_UINT32(EXIT_SUCCESS, io_set_input(pipe_path));
+    close(fds[0]);
+}
+
+/**
+ * @brief Write content to a temporary file and select it as the input.
+ * @param path Template for mkstemp(), receives the file name; unlink() it afterwards
+ */
+static void set_input_file(char* path, const void* content, size_t size)
+{
+    int fd = mkstemp(path);
+    TEST_ASSERT_TRUE(fd >= 0);
+    TEST_ASSERT_EQUAL_INT64(size, write(fd, content, size));
+    close(fd);
+    TEST_ASSERT_EQUAL_UINT32(EXIT_SUCCESS, io_set_input(path));
+}
+
+void test_input_override(void)
+{
+    char path[IO_MAX_PATH_LEN];
+    char** lines = NULL;
+    size_t line_count = 0;
+
+    /* A regular file replaces every input */
+    io_input_path("day03.txt", path);
+    TEST_ASSERT_EQUAL_UINT32(EXIT_SUCCESS, io_set_input(path));
+    TEST_ASSERT_FALSE(io_input_is_stream());
+    TEST_ASSERT_EQUAL_UINT32(357, day03_part1());
+
+    /* A pipe is read once and can be loaded repeatedly */
+    set_input_bytes("12\n34\n56", 8);
+    TEST_ASSERT_TRUE(io_input_is_stream());
+    for (int pass = 0; pass < 2; pass++)
+    {
+        TEST_ASSERT_EQUAL_UINT32(EXIT_SUCCESS, io_read_input("unused.txt", &lines, &line_count));
+        TEST_ASSERT_EQUAL_size_t(3, line_count);
+        TEST_ASSERT_EQUAL_STRING("56", lines[2]);
+        io_free_input(lines);
+    }
+}
+
+void test_reader_pipelined(void)
+{
+    char path[] = "/tmp/aoc_pipelineXXXXXX";
+    const size_t size = IO_PIPELINE_MIN_SIZE + IO_PIPELINE_CHUNK_SIZE;
+    char* content = malloc(size);
+    io_line_reader_t reader;
+    io_line_t line;
+
+    /*
+     * Line 1 straddles the first chunk boundary and line 2 spans more than
+     * two chunks. The rest are short; the last one has no newline.
+     */
+    TEST_ASSERT_NOT_NULL(content);
+    size_t expected_lines = 1;
+    for (size_t at = 0; at < size; at++)
+    {
+        content[at] = (char) ('a' + at % 26);
+    }
+    size_t newlines[] = {IO_PIPELINE_CHUNK_SIZE - 6, IO_PIPELINE_CHUNK_SIZE + 14, 3 * IO_PIPELINE_CHUNK_SIZE + 1000};
+    for (size_t index = 0; index < 3; index++, expected_lines++)
+    {
+        content[newlines[index]] = '\n';
+    }
+    for (size_t at = newlines[2] + 1 + expected_lines % 97; at + 1 < size; at += 1 + expected_lines % 97, expected_lines++)
+    {
+        content[at] = '\n';
+    }
+
+    set_input_file(path, content, size);
+
+    /* Every line must match what a plain scan of the content finds */
+    TEST_ASSERT_EQUAL_UINT32(EXIT_SUCCESS, io_reader_open("unused.txt", &reader));
+    TEST_ASSERT_NOT_NULL(reader.pipeline);
+    size_t start = 0, lines = 0, mismatches = 0;
+    while (io_reader_next(&reader, &line))
+    {
+        const char* newline = memchr(content + start, '\n', size - start);
+        size_t length = newline ? (size_t) (newline - (content + start)) : size - start;
+        if (length != line.length || 0 != memcmp(content + start, line.data, length))
+        {
+            mismatches++;
+        }
+        start += length + 1;
+        lines++;
+    }
+    TEST_ASSERT_FALSE(reader.error);
+    TEST_ASSERT_EQUAL_size_t(0, mismatches);
+    TEST_ASSERT_EQUAL_size_t(expected_lines, lines);
+    io_reader_close(&reader);
+
+    /* Closing early stops the reader thread while it waits for a free chunk */
+    TEST_ASSERT_EQUAL_UINT32(EXIT_SUCCESS, io_reader_open("unused.txt", &reader));
+    TEST_ASSERT_EQUAL_INT(1, io_reader_next(&reader, &line));
+    io_reader_close(&reader);
+
+    unlink(path);
+    free(content);
+}
+
+void test_day03_keep(void)
+{
+    const char* banks = "3141592653589793238462643383279502884197169399375105820974944592\n"
+                        "2718281828459045235360287471352662497757247093699959574966967627\n";
+
+    /* Keeping every battery of the 15-digit sample banks adds them up */
+    day03_set_keep(2);
+    TEST_ASSERT_EQUAL_UINT64(357, (uint64_t) day03_part2());
+    day03_set_keep(15);
+    TEST_ASSERT_EQUAL_UINT64(2851181577568619, (uint64_t) day03_part2());
+
+    /* 40 digits overflow a uint64_t, the decimal result stays exact */
+    set_input_bytes(banks, strlen(banks));
+    day03_set_keep(40);
+    char* joltage = day03_part2_str();
+    TEST_ASSERT_NOT_NULL(joltage);
+    TEST_ASSERT_EQUAL_STRING("19876232165381954416493075065395941912219", joltage);
+    free(joltage);
+}
+
+void test_day01_generated_tape(void)
+{
+    char path[] = "/tmp/aoc_day01XXXXXX";
+    const size_t count = 300000; /* several chunks of DAY01_CHUNK_MIN rotations */
+    int16_t* rotations = malloc(count * sizeof(int16_t));
+    char* text = malloc(count * 8);
+    size_t size = 0;
+    uint64_t stops, hits;
+
+    /* Mostly short turns, with full-range turns and whole laps mixed in */
+    TEST_ASSERT_NOT_NULL(rotations);
+    TEST_ASSERT_NOT_NULL(text);
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (size_t index = 0; index < count; index++)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint32_t random = (uint32_t) (state >> 33);
+        int16_t clicks = (int16_t) (random % 1000);
+        if (0 == random % 7)
+        {
+            clicks = (int16_t) (random % 32768);
+        }
+        else if (0 == random % 5)
+        {
+            clicks = (int16_t) (100 * (random % 300));
+        }
+        rotations[index] = (random & 1) ? (int16_t) -clicks : clicks;
+        size += (size_t) snprintf(text + size, 8, "%c%d\n", (random & 1) ? 'L' : 'R', clicks);
+    }
+
+    day01_count_zeros_scalar(rotations, count, &stops, &hits);
+    set_input_file(path, text, size);
+    for (unsigned threads = 1; threads <= 4; threads += 3)
+    {
+        parallel_set_thread_count(threads);
+        TEST_ASSERT_EQUAL_UINT64(stops, day01_part1());
+        TEST_ASSERT_EQUAL_UINT64(hits, day01_part2());
+    }
+
+    unlink(path);
+    free(text);
+    free(rotations);
+}
+
+void test_day01_malformed(void)
+{
+    /* A rotation that overflows, has trailing junk or no direction is an error, not 0 */
+    const char* tapes[] = {"R10\nR4294967296\n", "R10\nL5x\n", "R10\n12\n", "R10\nL\n"};
+    for (size_t index = 0; index < sizeof(tapes) / sizeof(tapes[0]); index++)
+    {
+        set_input_bytes(tapes[index], strlen(tapes[index]));
+        TEST_ASSERT_EQUAL_UINT64((uint64_t) -EXIT_FAILURE, day01_part1());
+    }
+
+    set_input_bytes("R50\r\nL100\r\n", 11);
+    TEST_ASSERT_EQUAL_UINT64(2, day01_part1());
+}
+
+void test_day02_brute_force(void)
+{
+    /* The ranges of the day 2 sample */
+    static const range_t sample[] = {{11, 22},
+                                     {95, 115},
+                                     {998, 1012},
+                                     {222220, 222224},
+                                     {446443, 446449},
+                                     {565653, 565659},
+                                     {1698522, 1698528},
+                                     {38593856, 38593862},
+                                     {824824821, 824824827},
+                                     {1188511880, 1188511890},
+                                     {2121212118, 2121212124}};
+    /* Long enough for AVX2 batches, crossing digit lengths, ending at UINT64_MAX */
+    static const range_t ranges[] = {{1, 100000},
+                                     {9999990000ULL, 10000010000ULL},
+                                     {9999999999999997000ULL, 10000000000000003000ULL},
+                                     {10000000001000000000ULL - 2000, 10000000001000000000ULL + 2001},
+                                     {UINT64_MAX - 5000, UINT64_MAX}};
+
+    TEST_ASSERT_EQUAL_UINT64(1010, return_value_if_invalid_id(1010));
+    TEST_ASSERT_EQUAL_UINT64(1188511885, return_value_if_invalid_id(1188511885));
+    TEST_ASSERT_EQUAL_UINT64(10000000001000000000ULL, return_value_if_invalid_id(10000000001000000000ULL));
+    TEST_ASSERT_EQUAL_UINT64(0, return_value_if_invalid_id(111));
+    TEST_ASSERT_EQUAL_UINT64(0, return_value_if_invalid_id(1011));
+    TEST_ASSERT_EQUAL_UINT64(0, return_value_if_invalid_id(UINT64_MAX));
+    TEST_ASSERT_EQUAL_UINT64(111, return_value_if_invalid_id_part2(111));
+    TEST_ASSERT_EQUAL_UINT64(824824824, return_value_if_invalid_id_part2(824824824));
+    TEST_ASSERT_EQUAL_UINT64(2121212121, return_value_if_invalid_id_part2(2121212121));
+    TEST_ASSERT_EQUAL_UINT64(10001000100010001000ULL, return_value_if_invalid_id_part2(10001000100010001000ULL));
+    TEST_ASSERT_EQUAL_UINT64(0, return_value_if_invalid_id_part2(12121));
+    TEST_ASSERT_EQUAL_UINT64(0, return_value_if_invalid_id_part2(UINT64_MAX));
+
+    TEST_ASSERT_EQUAL_UINT64(1227775554, day02_brute_force_sum(sample, 11, 0));
+    TEST_ASSERT_EQUAL_UINT64(4174379265, day02_brute_force_sum(sample, 11, 1));
+
+    /* The batched, sharded sum must match checking the IDs one by one */
+    uint64_t expected[2] = {0, 0};
+    for (size_t range = 0; range < sizeof(ranges) / sizeof(ranges[0]); range++)
+    {
+        for (uint64_t id = ranges[range].start;; id++)
+        {
+            expected[0] += return_value_if_invalid_id(id);
+            expected[1] += return_value_if_invalid_id_part2(id);
+            if (id == ranges[range].end_including)
+            {
+                break;
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT64(expected[0], day02_brute_force_sum(ranges, 5, 0));
+    TEST_ASSERT_EQUAL_UINT64(expected[1], day02_brute_force_sum(ranges, 5, 1));
+}
+
+#ifndef AOC_DAY02_BRUTE_FORCE
+void test_day02_wide_range(void)
+{
+    /* 10^12 IDs: only feasible without visiting every ID */
+    uint64_t expected = 0;
+    for (unsigned half = 1; half <= 6; half++)
+    {
+        for (uint64_t block = u64_pow10(half - 1); block < u64_pow10(half); block++)
+        {
+            expected += block * (u64_pow10(half) + 1);
+        }
+    }
+
+    set_input_bytes("1-999999999999", 14);
+    TEST_ASSERT_EQUAL_UINT64(expected, day02_part1());
+}
+#endif
+
+#ifdef AOC_HAVE_GZIP
+void test_gzip_input(void)
+{
+    /* gzip of "12\n34\n56\n" */
+    static const unsigned char compressed[] = {0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03,
+                                               0x33, 0x34, 0xe2, 0x32, 0x36, 0xe1, 0x32, 0x35, 0xe3, 0x02,
+                                               0x00, 0x40, 0x1f, 0x40, 0x4e, 0x09, 0x00, 0x00, 0x00};
+    char** lines = NULL;
+    size_t line_count = 0;
+
+    set_input_bytes(compressed, sizeof(compressed));
+
+    TEST_ASSERT_EQUAL_UINT32(EXIT_SUCCESS, io_read_input("unused.txt", &lines, &line_count));
+    TEST_ASSERT_EQUAL_size_t(3, line_count);
+    TEST_ASSERT_EQUAL_STRING("12", lines[0]);
+    TEST_ASSERT_EQUAL_STRING("56", lines[2]);
+    io_free_input(lines);
+}
+#endif
+
 void setUp(void) { /* Nothing to do – placeholder for Unity */ }
 
-void tearDown(void) { /* Nothing to do – placeholder for Unity */ }
+void tearDown(void)
+{
+    /* A failed assertion skips the rest of a test, so undo its settings here */
+    io_set_input(NULL);
+    day03_set_keep(0);
+    parallel_set_thread_count(0);
+}
 
 int main(void)
 {
     UNITY_BEGIN();
     RUN_TEST(test_day01_part1);
     RUN_TEST(test_day01_part2);
+    RUN_TEST(test_day01_generated_tape);
+    RUN_TEST(test_day01_malformed);
 
     RUN_TEST(test_day02_part1);
     RUN_TEST(test_day02_part2);
+    RUN_TEST(test_day02_brute_force);
 
     RUN_TEST(test_day03_part1);
     RUN_TEST(test_day03_part2);
+    RUN_TEST(test_day03_keep);
 
     RUN_TEST(test_day04_part1);
     RUN_TEST(test_day04_part2);
@@ -60,5 +632,29 @@ int main(void)
     
     RUN_TEST(test_day07_part1);
     RUN_TEST(test_day07_part2);
+
+    RUN_TEST(test_parse_u32);
+    RUN_TEST(test_parse_u64);
+    RUN_TEST(test_parse_u128);
+
+    RUN_TEST(test_tokenizer_delimiter);
+    RUN_TEST(test_tokenizer_whitespace);
+    RUN_TEST(test_u64_format);
+
+    RUN_TEST(test_radix_sort_uint64);
+    RUN_TEST(test_radix_sort_range);
+    RUN_TEST(test_introsort);
+    RUN_TEST(test_parallel_sort);
+    RUN_TEST(test_counting_sort);
+    RUN_TEST(test_interval_set);
+
+    RUN_TEST(test_input_override);
+    RUN_TEST(test_reader_pipelined);
+#ifndef AOC_DAY02_BRUTE_FORCE
+    RUN_TEST(test_day02_wide_range);
+#endif
+#ifdef AOC_HAVE_GZIP
+    RUN_TEST(test_gzip_input);
+#endif
     return UNITY_END();
 }
\ No newline at end of file